@@ -12,8 +12,114 @@
 #define _LIBCRCPP_H_
 
 #include <stdint.h>                                     // uint8_t
-#include <stdlib.h>                                     // size_t
-#include <type_traits>                                  // std::enable_if_t, std::is_unsigned
+#include <stdlib.h>                                     // size_t, getenv
+#include <string.h>                                     // memcpy, strcmp
+#include <algorithm>                                    // std::min
+#include <atomic>                                       // std::atomic
+#include <condition_variable>                           // std::condition_variable
+#include <deque>                                        // std::deque
+#include <exception>                                    // std::exception_ptr
+#include <functional>                                   // std::function
+#include <memory>                                       // std::unique_ptr, std::shared_ptr
+#include <mutex>                                        // std::mutex
+#include <string>                                       // std::string
+#include <thread>                                       // std::thread
+#include <type_traits>                                  // std::enable_if_t, std::is_unsigned, std::true_type
+#include <unordered_map>                                // std::unordered_map
+#include <vector>                                       // std::vector
+#if __cplusplus >= 201703L
+#include <string_view>                                  // std::string_view
+#endif
+#if __cplusplus >= 202002L
+#include <ranges>                                       // std::ranges
+#include <span>                                         // std::span
+#endif
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>                                    // std::coroutine_handle
+#endif
+#if defined(LIBCRC_STATS)
+#include <chrono>                                       // std::chrono::steady_clock
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>                                    // iovec
+#define LIBCRC_IOVEC
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>                                // SYS_getcpu, SYS_mbind
+#include <unistd.h>                                     // syscall, sysconf
+#define LIBCRC_NUMA
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBCRC_X86 1
+#include <cpuid.h>                                      // __get_cpuid
+#include <immintrin.h>                                  // PCLMULQDQ, SSE intrinsics
+#elif defined(__aarch64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBCRC_ARM64 1
+#include <arm_acle.h>                                   // CRC32 intrinsics
+#include <arm_neon.h>                                   // PMULL intrinsics
+#include <sys/auxv.h>                                   // getauxval
+#include <asm/hwcap.h>                                  // HWCAP_PMULL, HWCAP_CRC32
+#endif
+
+/**
+ * @brief     Asks the compiler to fully unroll the next loop. The loops marked with it have a small, constant trip
+ *            count and only perform well when the iterations are laid out one after the other.
+ */
+#if defined(__clang__)
+#define LIBCRC_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define LIBCRC_UNROLL _Pragma("GCC unroll 16")
+#else
+#define LIBCRC_UNROLL
+#endif
+
+/**
+ * @brief     Function attributes to compile a kernel for an instruction set extension not enabled in the build.
+ *            Kernels are only called after checking at runtime that the CPU supports the extension.
+ */
+#if defined(LIBCRC_X86)
+#define LIBCRC_TARGET_CLMUL __attribute__((target("pclmul,ssse3,sse4.1")))
+#define LIBCRC_TARGET_CRC32 __attribute__((target("sse4.2,pclmul")))
+#elif defined(LIBCRC_ARM64) && defined(__clang__)
+#define LIBCRC_TARGET_CLMUL __attribute__((target("aes")))
+#define LIBCRC_TARGET_CRC32 __attribute__((target("crc,aes")))
+#elif defined(LIBCRC_ARM64)
+#define LIBCRC_TARGET_CLMUL __attribute__((target("+crypto")))
+#define LIBCRC_TARGET_CRC32 __attribute__((target("+crc+crypto")))
+#endif
+
+#if defined(LIBCRC_X86) && (defined(__clang__) || __GNUC__ >= 8)
+#define LIBCRC_TARGET_VPCLMUL __attribute__((target("avx512f,avx512bw,avx512vl,vpclmulqdq,pclmul,ssse3,sse4.1")))
+#endif
+
+/**
+ * @brief     The build enables the CRC instructions, so the code using them can be inlined without checking the CPU.
+ */
+#if defined(LIBCRC_X86) && defined(__SSE4_2__) && defined(__PCLMUL__)
+#define LIBCRC_NATIVE_CRC32 1
+#elif defined(LIBCRC_ARM64) && defined(__ARM_FEATURE_CRC32) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define LIBCRC_NATIVE_CRC32 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBCRC_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define LIBCRC_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief     Tells whether the code is being evaluated at compile time, to choose operations allowed in constexpr.
+ */
+#if defined(__cpp_lib_is_constant_evaluated)
+#define LIBCRC_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#define LIBCRC_HAS_CONSTANT_EVALUATED 1
+#elif defined(__GNUC__) && (__GNUC__ >= 9 || defined(__clang__))
+#define LIBCRC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#define LIBCRC_HAS_CONSTANT_EVALUATED 1
+#else
+#define LIBCRC_IS_CONSTANT_EVALUATED() false
+#endif
 
 namespace libcrc {
 
@@ -26,23 +132,70 @@ enum ShiftDir
     shiftRight
 };
 
+#if defined(__SIZEOF_INT128__)
+#define LIBCRC_INT128 1
+__extension__ typedef unsigned __int128 uint128_t;     //!< Register type for CRCs wider than 64 bits
+#endif
+
+/**
+ * @brief     Tells whether a type can be used as the register of a calculator: any unsigned integer type, including
+ *            the 128-bit one where the compiler has it.
+ */
+template <typename T>
+struct IsRegister : std::is_unsigned<T>
+{ };
+
+#if defined(LIBCRC_INT128)
+template <>
+struct IsRegister<uint128_t> : std::true_type
+{ };
+#endif
+
 /** ----------------------------------------------------
  * @brief     Auxiliary functions
  * ------ */
+/**
+ * @brief     Reverse order of bytes of a word.
+ */
+template <typename W>
+constexpr W                                             /** @return Value with the bytes in reverse order */
+byteSwap(
+    W word                                              /** @param word  Value to reverse */
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(W) == 8)
+        return W(__builtin_bswap64(uint64_t(word)));
+    if (sizeof(W) == 4)
+        return W(__builtin_bswap32(uint32_t(word)));
+    if (sizeof(W) == 2)
+        return W(__builtin_bswap16(uint16_t(word)));
+#endif
+    W result = 0;
+    for (unsigned idx = 0; idx < sizeof(W); ++idx, word >>= 8)
+        result = W(result << 8) | (word & 0xff);
+    return result;
+}
+
 /**
  * @brief     Reverse order of bits of a word.
+ * @desc      The bits are swapped in pairs, then the pairs and the nibbles, with masks as wide as the word, and the
+ *            bytes are reversed at last: a handful of operations whatever the size of the word.
  */
 template <typename T>
-T                                                       /** @return Value with the bits in reverse order */
+constexpr T                                             /** @return Value with the bits in reverse order */
 reverse(
     T word                                              /** @param word  Value to reverse */
 )
 {
-    T result = 0;
-    for (unsigned bit = 0; bit < sizeof(T) * 8; ++bit)
-        if (word & (1 << bit))
-            result |= 1 << ((sizeof(T) * 8) - bit - 1);
-    return result;
+    const T ones = T(~T(0));
+    const T odd = T(ones / 3);                          // 0x55...
+    const T pairs = T(ones / 5);                        // 0x33...
+    const T nibbles = T(ones / 17);                     // 0x0F...
+    word = T(((word >> 1) & odd) | T((word & odd) << 1));
+    word = T(((word >> 2) & pairs) | T((word & pairs) << 2));
+    word = T(((word >> 4) & nibbles) | T((word & nibbles) << 4));
+    return byteSwap(word);
 }
 
 /** ----------------------------------------------------
@@ -55,7 +208,7 @@ struct Shifter
     /**
      * @brief     Shift a value the specified amount of bits.
      */
-    T                                                   /** @return Value shifted */
+    constexpr T                                         /** @return Value shifted */
     shift(
         T data,                                         /** @param data Value to shift */
         int bits                                        /** @param bits Number of bits to shift */
@@ -68,7 +221,7 @@ struct Shifter
 template <typename T>
 struct Shifter<T, shiftLeft>
 {
-    T                                                   /** @return Value shifted */
+    constexpr T                                         /** @return Value shifted */
     shift(
         T data,                                         /** @param data Value to shift */
         int bits                                        /** @param bits Number of bits to shift */
@@ -84,7 +237,7 @@ struct Shifter<T, shiftLeft>
 template <typename T>
 struct Shifter<T, shiftRight>
 {
-    T                                                   /** @return Value shifted */
+    constexpr T                                         /** @return Value shifted */
     shift(
         T data,                                         /** @param data Value to shift */
         int bits                                        /** @param bits Number of bits to shift */
@@ -95,113 +248,4676 @@ struct Shifter<T, shiftRight>
 };
 
 /** ----------------------------------------------------
- * @brief     Class CrcCalc: CRC calculator without table.
+ * @brief     Auxiliary functions: word access in data stream order.
+ * @desc      A word is composed so that the byte that comes first in the stream lands where a CRC register of the
+ *            same shift direction expects it: least significant byte for right shifting, most significant byte for
+ *            left shifting. Words are composed byte by byte when evaluated at compile time.
+ * ------ */
+/**
+ * @brief     Reads a word from the data stream.
+ */
+template <typename W, ShiftDir dir>
+constexpr W                                             /** @return Word read from the data stream */
+loadWord(
+    const uint8_t* data                                 /** @param data  Pointer to the first byte of the word */
+)
+{
+    W word = 0;
+    if (LIBCRC_IS_CONSTANT_EVALUATED())
+    {
+        for (unsigned idx = 0; idx < sizeof(W); ++idx)
+            word |= W(data[idx]) << ((dir == shiftRight)? idx * 8 : (sizeof(W) - idx - 1) * 8);
+        return word;
+    }
+    memcpy(&word, data, sizeof(W));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return (dir == shiftRight)? byteSwap(word) : word;
+#else
+    return (dir == shiftLeft)? byteSwap(word) : word;
+#endif
+}
+
+/** ----------------------------------------------------
+ * @brief     Struct CpuFeatures: Instruction set extensions usable by the accelerated calculators.
  * ------ */
-template <typename T, ShiftDir dir, typename = std::enable_if_t<std::is_unsigned<T>::value>>
-class CrcCalc
+struct CpuFeatures
 {
-public:
-    /**
-     * @brief     Constructor. Initializes to zero.
-     */
-    CrcCalc(
-      T poly                                            /** @param poly Polynomial to use for the computation */
-    ) : shifter_(),
-        polynomial_(dir == shiftLeft? poly : libcrc::reverse(poly)),
-        mask_(dir == shiftLeft? (1 << ((sizeof(T) * 8) - 1)) : 1),
-        pack_(dir == shiftLeft? ((sizeof(T) - 1) * 8) : 0)
-    { };
+    bool clmul = false;                                 //!< 64-bit carry-less multiplication (x86 PCLMULQDQ, ARMv8 PMULL)
+    bool crc32c = false;                                //!< CRC-32C instruction (x86 SSE4.2, ARMv8 CRC32)
+    bool crc32 = false;                                 //!< CRC-32 (0x04C11DB7) instruction (ARMv8 CRC32)
+    bool vpclmul = false;                               //!< 512-bit carry-less multiplication (x86 AVX-512 VPCLMULQDQ)
 
     /**
-     * @brief     Computes the CRC of a data block.
+     * @brief     Features of the CPU the program is running on. Detected once, on first use.
      */
-    T                                                   /** @return Computed CRC */
-    compute (
-        const uint8_t* data,                            /** @param data    Pointer to the data block to compute CRC */
-        size_t length,                                  /** @param length  Data length */
-        T seed = 0                                      /** @param seed    Seed or computed CRC from the previous block */
-    ) const
+    static const CpuFeatures&                           /** @return Detected features */
+    get()
     {
-        T result = seed;
-        while (length--)
+        static const CpuFeatures features = detect();
+        return features;
+    };
+
+private:
+    static CpuFeatures
+    detect()
+    {
+        CpuFeatures features;
+#if defined(LIBCRC_X86)
+        unsigned eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
         {
-            result ^= (*data++) << pack_;
-            for (int bit = 8; bit > 0; --bit)
-                if (result & mask_)
-                  result = shifter_.shift(result, 1) ^ polynomial_;
-              else
-                  result = shifter_.shift(result, 1);
+            features.clmul = (ecx & bit_PCLMUL) && (ecx & bit_SSSE3) && (ecx & bit_SSE4_1);
+            features.crc32c = (ecx & bit_SSE4_2) != 0;
         }
-        return result;
+        bool zmm_state = false;                         // The OS saves the AVX-512 registers
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_OSXSAVE))
+        {
+            unsigned xcr0, xcr0_high;
+            __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0));
+            zmm_state = (xcr0 & 0xE6) == 0xE6;          // SSE, AVX, opmask and ZMM state
+        }
+        if (zmm_state && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        {
+            const bool avx512 = (ebx & (1u << 16)) && (ebx & (1u << 30)) && (ebx & (1u << 31));   // F, BW, VL
+            features.vpclmul = features.clmul && avx512 && (ecx & (1u << 10));                   // VPCLMULQDQ
+        }
+#elif defined(LIBCRC_ARM64)
+        unsigned long hwcap = getauxval(AT_HWCAP);
+        features.clmul = (hwcap & HWCAP_PMULL) != 0;
+        features.crc32c = features.crc32 = (hwcap & HWCAP_CRC32) != 0;
+#endif
+        return features;
     };
+};
 
-private:
-    Shifter<T, dir> shifter_;                           //!< Bit shifter
-    T polynomial_;                                      //!< Polynomial used in the CRC computation
-    const T   mask_;                                    //!< Bit mask with the next bit to be processed according to the processing direction set to 1
-    const int pack_;                                    //!< Number of bits to shift to pack a byte inside a word
+/** ----------------------------------------------------
+ * @brief     Engines of the calculators, as selected by CrcAutoCalc and counted by Stats.
+ * ------ */
+enum CrcEngine
+{
+    engineAuto,                                         //!< Fastest engine available for the CPU and the polynomial
+    engineBitwise,                                      //!< CrcCalc
+    engineNibble,                                       //!< CrcNibbleCalc
+    engineBarrett,                                      //!< CrcBarrettCalc
+    engineTable,                                        //!< CrcFastCalc
+    engineSlicing,                                      //!< CrcSlicingCalc, slicing-by-8
+    engineClmul,                                        //!< CrcClmulCalc, 128-bit instructions only
+    engineClmulWide,                                    //!< CrcClmulCalc, with the 512-bit instructions for long blocks
+    engineHardware                                      //!< CrcHwCalc, CRC instructions of the CPU
 };
 
+/**
+ * @brief     Names of the engines, as accepted in the environment variable LIBCRC_ENGINE.
+ */
+inline const char*                                      /** @return Name of the engine */
+engineName(
+    CrcEngine engine                                    /** @param engine  Engine */
+)
+{
+    switch (engine)
+    {
+        case engineBitwise:     return "bitwise";
+        case engineNibble:      return "nibble";
+        case engineBarrett:     return "barrett";
+        case engineTable:       return "table";
+        case engineSlicing:     return "slicing";
+        case engineClmul:       return "clmul";
+        case engineClmulWide:   return "clmul-avx512";
+        case engineHardware:    return "hardware";
+        default:                return "auto";
+    }
+}
+
+/**
+ * @brief     Engine with the given name.
+ */
+inline CrcEngine                                        /** @return Engine, or engineAuto if the name is unknown or null */
+engineFromName(
+    const char* name                                    /** @param name    Name of the engine */
+)
+{
+    static const CrcEngine engines[] = { engineBitwise, engineNibble, engineBarrett, engineTable, engineSlicing, engineClmul,
+                                         engineClmulWide, engineHardware };
+    for (CrcEngine engine : engines)
+        if (name != nullptr && strcmp(name, engineName(engine)) == 0)
+            return engine;
+    return engineAuto;
+}
+
+#if defined(LIBCRC_STATS)
 /** ----------------------------------------------------
- * @brief     Class CrcFastCalc: CRC calculador with lookup table.
+ * @brief     Instrumentation, built when LIBCRC_STATS is defined: calls and bytes computed by every engine.
+ * @desc      Every engine counts the bytes it processes itself, so a call is split among the engines taking part in it:
+ *            the bytes folded by CrcClmulCalc are counted as engineClmul and its tail as engineSlicing. CrcFastCalcT,
+ *            which may run at compile time, is not counted. Counters are updated with relaxed atomic operations;
+ *            cycles are only measured in one of every 'sampling' calls, and never by default.
+ * ------ */
+constexpr unsigned engine_count = engineHardware + 1;   //!< Number of engines, including engineAuto
+constexpr unsigned stats_buckets = 12;                  //!< Size classes in the histogram of call sizes
+
+/**
+ * @brief     Counters of an engine.
+ */
+struct EngineStats
+{
+    uint64_t calls;                                     //!< Calls
+    uint64_t bytes;                                     //!< Bytes computed
+    uint64_t sizes[stats_buckets];                      //!< Calls by size: bucket b for sizes below 16 * 4^b, the last one for the rest
+    uint64_t sampled_calls;                             //!< Calls whose cycles were measured
+    uint64_t sampled_bytes;                             //!< Bytes computed in them
+    uint64_t sampled_cycles;                            //!< Cycles spent in them: time stamp counter in x86-64, nanoseconds elsewhere
+
+    /**
+     * @brief     Provides the upper limit of a bucket of the histogram.
+     */
+    static constexpr uint64_t                           /** @return Smallest size not in the bucket; UINT64_MAX for the last one */
+    bucketLimit(
+      unsigned bucket                                   /** @param bucket  Bucket */
+    )
+    {
+        return (bucket + 1 < stats_buckets)? uint64_t(16) << (2 * bucket) : UINT64_MAX;
+    };
+
+    /**
+     * @brief     Provides the cycles per byte of the sampled calls.
+     */
+    double                                              /** @return Cycles per byte; 0 if no call was sampled */
+    cyclesPerByte() const
+    {
+        return (sampled_bytes != 0)? double(sampled_cycles) / double(sampled_bytes) : 0;
+    };
+};
+
+/**
+ * @brief     Counters of every engine at a given moment.
+ */
+struct StatsSnapshot
+{
+    EngineStats engines[engine_count];                  //!< Counters, indexed by CrcEngine
+
+    const EngineStats&                                  /** @return Counters of the engine */
+    operator[](
+      CrcEngine engine                                  /** @param engine  Engine */
+    ) const
+    {
+        return engines[engine];
+    };
+};
+
+/** ----------------------------------------------------
+ * @brief     Class Stats: process-wide counters of the engines.
  * ------ */
-template <typename T, ShiftDir dir, typename = std::enable_if_t<std::is_unsigned<T>::value>>
-class CrcFastCalc
+class Stats
 {
 public:
     /**
-     * @brief     Constructor. Initializes the precalculated table.
+     * @brief     Single instance of the counters.
      */
-    CrcFastCalc(
-      T poly                                            /** @param poly Polynomial to use for the computation */
-    ) : shifter_(),
-        polynomial_(dir == shiftLeft? poly : libcrc::reverse(poly)),
-        mask_(dir == shiftLeft? (1 << ((sizeof(T) * 8) - 1)) : 1),
-        pack_(dir == shiftLeft? ((sizeof(T) - 1) * 8) : 0)
+    static Stats&                                       /** @return Counters */
+    get()
     {
-        for (unsigned idx = 0; idx < 256; ++idx)
+        static Stats stats;
+        return stats;
+    };
+
+    /**
+     * @brief     Sets how often the cycles of a call are measured.
+     */
+    void
+    setSampling(
+      unsigned period                                   /** @param period  One of every 'period' calls is measured; 0 for none */
+    )
+    {
+        sampling_.store(period, std::memory_order_relaxed);
+    };
+
+    /**
+     * @brief     Provides a copy of the counters. Counters updated meanwhile by other threads may be partially included.
+     */
+    StatsSnapshot                                       /** @return Counters of every engine */
+    snapshot() const
+    {
+        StatsSnapshot result;
+        for (unsigned engine = 0; engine < engine_count; ++engine)
         {
-            T result = idx << pack_;
-            for (int bit = 8; bit > 0; --bit)
-                if (result & mask_)
-                    result = shifter_.shift(result, 1) ^ polynomial_;
-                else
-                    result = shifter_.shift(result, 1);
-            lookup_table_[idx] = result;
+            const Counters& from = counters_[engine];
+            EngineStats& to = result.engines[engine];
+            to.calls = from.calls.load(std::memory_order_relaxed);
+            to.bytes = from.bytes.load(std::memory_order_relaxed);
+            for (unsigned bucket = 0; bucket < stats_buckets; ++bucket)
+                to.sizes[bucket] = from.sizes[bucket].load(std::memory_order_relaxed);
+            to.sampled_calls = from.sampled_calls.load(std::memory_order_relaxed);
+            to.sampled_bytes = from.sampled_bytes.load(std::memory_order_relaxed);
+            to.sampled_cycles = from.sampled_cycles.load(std::memory_order_relaxed);
         }
+        return result;
     };
 
     /**
-     * @brief     Provides a pointer to the lookup table.
+     * @brief     Sets every counter to zero.
      */
-    const T*                                            /** @return Precalculated lookup table */
-    getLookupTable() const
+    void
+    reset()
     {
-        return lookup_table_;
+        for (Counters& counters : counters_)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.bytes.store(0, std::memory_order_relaxed);
+            for (std::atomic<uint64_t>& size : counters.sizes)
+                size.store(0, std::memory_order_relaxed);
+            counters.sampled_calls.store(0, std::memory_order_relaxed);
+            counters.sampled_bytes.store(0, std::memory_order_relaxed);
+            counters.sampled_cycles.store(0, std::memory_order_relaxed);
+        }
     };
 
     /**
-     * @brief     Computes the CRC of a data block.
+     * @brief     Counts a call.
      */
-    T                                                   /** @return Computed CRC */
-    compute (
-      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+    bool                                                /** @return true if the cycles of the call must be measured */
+    count(
+      CrcEngine engine,                                 /** @param engine  Engine */
+      size_t length                                     /** @param length  Data length */
+    )
+    {
+        Counters& counters = counters_[engine];
+        uint64_t call = counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(length, std::memory_order_relaxed);
+        unsigned bucket = 0;
+        while (bucket + 1 < stats_buckets && length >= EngineStats::bucketLimit(bucket))
+            ++bucket;
+        counters.sizes[bucket].fetch_add(1, std::memory_order_relaxed);
+        unsigned period = sampling_.load(std::memory_order_relaxed);
+        return period != 0 && call % period == 0;
+    };
+
+    /**
+     * @brief     Adds the cycles of a measured call.
+     */
+    void
+    sample(
+      CrcEngine engine,                                 /** @param engine  Engine */
       size_t length,                                    /** @param length  Data length */
-      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
-    ) const
+      uint64_t cycles                                   /** @param cycles  Cycles spent */
+    )
     {
-        T result = seed;
-        while (length--)
-            result = shifter_.shift(result, 8) ^ lookup_table_[((result >> pack_) ^ (*data++)) & 0xff];
-        return result;
+        Counters& counters = counters_[engine];
+        counters.sampled_calls.fetch_add(1, std::memory_order_relaxed);
+        counters.sampled_bytes.fetch_add(length, std::memory_order_relaxed);
+        counters.sampled_cycles.fetch_add(cycles, std::memory_order_relaxed);
+    };
+
+    /**
+     * @brief     Reads the cycle counter.
+     */
+    static uint64_t                                     /** @return Time stamp counter in x86-64, nanoseconds elsewhere */
+    cycles()
+    {
+#if defined(LIBCRC_X86)
+        return __rdtsc();
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
     };
 
 private:
-    Shifter<T, dir> shifter_;                           //!< Bit shifter
-    T polynomial_;                                      //!< Polynomial used in the CRC computation
-    const T   mask_;                                    //!< Bit mask with the next bit to be processed according to the processing direction set to 1
-    const int pack_;                                    //!< Number of bits to shift to pack a byte inside a word
-    T lookup_table_[256];                               //!< Precalculated lookup table
+    struct alignas(64) Counters                         // Own cache line for every engine
+    {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> sizes[stats_buckets] = {};
+        std::atomic<uint64_t> sampled_calls{0};
+        std::atomic<uint64_t> sampled_bytes{0};
+        std::atomic<uint64_t> sampled_cycles{0};
+    };
+
+    Stats() = default;
+
+    Counters counters_[engine_count];                   //!< Counters, indexed by CrcEngine
+    std::atomic<unsigned> sampling_{0};                 //!< Sampling period of the cycles; 0 for none
+};
+
+/**
+ * @brief     Counts a call to an engine, and measures its cycles if it is sampled, until the end of the scope.
+ */
+class StatsScope
+{
+public:
+    StatsScope(CrcEngine engine, size_t length)
+        : engine_(engine), length_(length), start_(Stats::get().count(engine, length)? Stats::cycles() : 0)
+    { };
+
+    ~StatsScope()
+    {
+        if (start_ != 0)
+            Stats::get().sample(engine_, length_, Stats::cycles() - start_);
+    };
+
+    StatsScope(const StatsScope&) = delete;
+    StatsScope& operator=(const StatsScope&) = delete;
+
+private:
+    CrcEngine engine_;
+    size_t length_;
+    uint64_t start_;                                    //!< Cycle counter at the start; 0 if not sampled
+};
+
+#define LIBCRC_STATS_SCOPE(engine, length) ::libcrc::StatsScope libcrc_stats_scope_(engine, length)
+#else
+#define LIBCRC_STATS_SCOPE(engine, length)
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Auxiliary functions: arithmetic modulo a polynomial of degree 64.
+ * @desc      The polynomial is G(x) = x^64 + g(x), where g is given as a 64-bit word with the coefficient of x^63 in the
+ *            most significant bit. A CRC of any width up to 64 bits becomes a CRC of this kind when its polynomial is
+ *            multiplied by x^(64 - width), which is what the carry-less multiplication engines work on.
+ * ------ */
+/**
+ * @brief     Computes x^e mod G.
+ */
+inline uint64_t                                         /** @return Remainder, in normal (not reflected) bit order */
+xPowMod(
+    unsigned e,                                         /** @param e  Exponent */
+    uint64_t g                                          /** @param g  Polynomial G without its x^64 term */
+)
+{
+    uint64_t result = 1;
+    while (e--)
+        result = (result << 1) ^ ((result >> 63)? g : 0);
+    return result;
+}
+
+/**
+ * @brief     Computes the Barrett constant floor(x^128 / G).
+ */
+inline uint64_t                                         /** @return Quotient without its x^64 term */
+barrettQuotient(
+    uint64_t g                                          /** @param g  Polynomial G without its x^64 term */
+)
+{
+    uint64_t quotient = 0;
+    uint64_t remainder = g;                             // x^128 - x^64 * G
+    for (int bit = 63; bit >= 0; --bit)
+    {
+        uint64_t top = remainder >> 63;
+        quotient |= top << bit;
+        remainder = (remainder << 1) ^ (top? g : 0);
+    }
+    return quotient;
+}
+
+/** ----------------------------------------------------
+ * @brief     Auxiliary functions: table driven computation.
+ * @desc      Shared by the calculators whose tables are built at runtime and the ones built at compile time.
+ * ------ */
+/**
+ * @brief     Container of N lookup tables. Table k holds the CRC of every byte value followed by k zero bytes.
+ */
+template <typename T, unsigned N>
+struct LookupTables
+{
+    alignas(64) T table[N][256];                        //!< Lookup tables, aligned to a cache line
+};
+
+/**
+ * @brief     Shifts the eight bits of a byte through the register, applying the polynomial bit by bit.
+ */
+template <typename T, ShiftDir dir>
+constexpr T                                             /** @return Register after processing the byte */
+divideByte(
+    T result,                                           /** @param result      Register with the byte already added */
+    T polynomial                                        /** @param polynomial  Polynomial, already reversed for right shifting */
+)
+{
+    const T mask = (dir == shiftLeft)? T(T(1) << ((sizeof(T) * 8) - 1)) : T(1);
+    for (int bit = 8; bit > 0; --bit)
+        if (result & mask)
+            result = Shifter<T, dir>().shift(result, 1) ^ polynomial;
+        else
+            result = Shifter<T, dir>().shift(result, 1);
+    return result;
+}
+
+/**
+ * @brief     Shifts the eight bits of a byte through the register without branches: the polynomial is masked by the
+ *            bit shifted out instead of being tested.
+ */
+template <typename T, ShiftDir dir>
+constexpr T                                             /** @return Register after processing the byte */
+divideByteMasked(
+    T result,                                           /** @param result      Register with the byte already added */
+    T polynomial                                        /** @param polynomial  Polynomial, already reversed for right shifting */
+)
+{
+    LIBCRC_UNROLL
+    for (int bit = 8; bit > 0; --bit)
+    {
+        T out = (dir == shiftLeft)? T(result >> ((sizeof(T) * 8) - 1)) : T(result & 1);
+        result = Shifter<T, dir>().shift(result, 1) ^ T(polynomial & T(0 - out));
+    }
+    return result;
+}
+
+/**
+ * @brief     Fills consecutive lookup tables for a polynomial.
+ */
+template <typename T, ShiftDir dir>
+constexpr void
+fillLookupTables(
+    T poly,                                             /** @param poly    Polynomial, as given to the constructors */
+    T (*tables)[256],                                   /** @param tables  Tables to fill */
+    unsigned slices                                     /** @param slices  Number of tables */
+)
+{
+    const T polynomial = (dir == shiftLeft)? poly : libcrc::reverse(poly);
+    const int pack = (dir == shiftLeft)? ((sizeof(T) - 1) * 8) : 0;
+    tables[0][0] = 0;
+    for (unsigned bit = 1; bit < 256; bit <<= 1)        // The CRC is linear: entry a ^ b is entry a ^ entry b
+    {
+        const T single = divideByte<T, dir>(T(T(bit) << pack), polynomial);
+        for (unsigned idx = 0; idx < bit; ++idx)
+            tables[0][bit + idx] = single ^ tables[0][idx];
+    }
+    for (unsigned slice = 1; slice < slices; ++slice)
+        for (unsigned idx = 0; idx < 256; ++idx)
+        {
+            T prev = tables[slice - 1][idx];
+            tables[slice][idx] = Shifter<T, dir>().shift(prev, 8) ^ tables[0][(prev >> pack) & 0xff];
+        }
+}
+
+/**
+ * @brief     Builds N lookup tables for a polynomial.
+ */
+template <typename T, ShiftDir dir, unsigned N>
+constexpr LookupTables<T, N>                            /** @return Lookup tables */
+makeLookupTables(
+    T poly                                              /** @param poly  Polynomial, as given to the constructors */
+)
+{
+    LookupTables<T, N> tables = {};
+    fillLookupTables<T, dir>(poly, tables.table, N);
+    return tables;
+}
+
+/**
+ * @brief     Processes a single byte with a lookup table.
+ */
+template <typename T, ShiftDir dir>
+constexpr T                                             /** @return Updated CRC */
+tableStep(
+    const T* table,                                     /** @param table   Lookup table */
+    T result,                                           /** @param result  Current CRC */
+    uint8_t byte                                        /** @param byte    Byte to process */
+)
+{
+    return Shifter<T, dir>().shift(result, 8) ^ table[((result >> ((dir == shiftLeft)? ((sizeof(T) - 1) * 8) : 0)) ^ byte) & 0xff];
+}
+
+/**
+ * @brief     Part of the register that overlaps the j-th word of a block, aligned as the word read from memory.
+ */
+template <typename T, ShiftDir dir, typename W>
+constexpr W                                             /** @return Register bits to add to the word */
+registerPart(
+    T result,                                           /** @param result  Current CRC */
+    unsigned word                                       /** @param word    Index of the word inside the block */
+)
+{
+    constexpr unsigned reg_bits = sizeof(T) * 8;
+    constexpr unsigned word_bits = sizeof(W) * 8;
+    const unsigned low = word * word_bits;              // Stream bits covered by the word: [low, low + word_bits)
+    if (low >= reg_bits)
+        return 0;
+    if (dir == shiftRight)
+        return W(result >> low);
+    if (reg_bits >= low + word_bits)
+        return W(result >> (reg_bits - low - word_bits));
+    return W(W(result) << (low + word_bits - reg_bits));
+}
+
+/**
+ * @brief     Processes a block of N bytes with N lookup tables ("slicing-by-N").
+ */
+template <typename T, ShiftDir dir, unsigned N>
+constexpr T                                             /** @return Updated CRC */
+sliceBlock(
+    const T (*tables)[256],                             /** @param tables  N lookup tables */
+    const uint8_t* data,                                /** @param data    Pointer to the block */
+    T result                                            /** @param result  Current CRC */
+)
+{
+    using W = std::conditional_t<N == 4, uint32_t, uint64_t>;
+    constexpr unsigned reg_bits = sizeof(T) * 8;
+    T next = (reg_bits > N * 8)? Shifter<T, dir>().shift(result, (N * 8) % reg_bits) : 0;
+    LIBCRC_UNROLL
+    for (unsigned word = 0; word < N / sizeof(W); ++word)
+    {
+        W value = loadWord<W, dir>(data + word * sizeof(W)) ^ registerPart<T, dir, W>(result, word);
+        LIBCRC_UNROLL
+        for (unsigned idx = 0; idx < sizeof(W); ++idx)
+        {
+            unsigned byte = (dir == shiftRight)? (value >> (idx * 8)) & 0xff : (value >> ((sizeof(W) - idx - 1) * 8)) & 0xff;
+            next ^= tables[N - 1 - word * sizeof(W) - idx][byte];
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief     Processes a step of N bytes: a block with N lookup tables, or a single byte when N is 1.
+ */
+template <typename T, ShiftDir dir, unsigned N>
+constexpr T                                             /** @return Updated CRC */
+sliceStep(
+    const T (*tables)[256],                             /** @param tables  N lookup tables */
+    const uint8_t* data,                                /** @param data    Pointer to the step */
+    T result                                            /** @param result  Current CRC */
+)
+{
+    return (N == 1)? tableStep<T, dir>(tables[0], result, *data) : sliceBlock<T, dir, (N > 1)? N : 4>(tables, data, result);
+}
+
+/**
+ * @brief     Computes the CRC of a data block with N lookup tables.
+ */
+template <typename T, ShiftDir dir, unsigned N>
+constexpr T                                             /** @return Computed CRC */
+sliceCompute(
+    const T (*tables)[256],                             /** @param tables  N lookup tables */
+    const uint8_t* data,                                /** @param data    Pointer to the data block */
+    size_t length,                                      /** @param length  Data length */
+    T result                                            /** @param result  Seed or computed CRC from the previous block */
+)
+{
+    if (N > 1)
+        for (; length >= N; length -= N, data += N)
+            result = sliceStep<T, dir, N>(tables, data, result);
+    while (length--)
+        result = tableStep<T, dir>(tables[0], result, *data++);
+    return result;
+}
+
+/**
+ * @brief     Computes the CRCs of several data blocks, S at a time, so that their lookups overlap.
+ * @desc      The CRC of a single block is a chain of dependent lookups; S independent chains keep S lookups in flight.
+ *            Every lane takes the next block as soon as its own is done, so blocks of different lengths keep all the
+ *            lanes busy. The last blocks, when there are not enough to fill the lanes, are computed one by one.
+ */
+template <typename T, ShiftDir dir, unsigned N, unsigned S>
+void
+sliceBatch(
+    const T (*tables)[256],                             /** @param tables   N lookup tables */
+    const uint8_t* const* data,                         /** @param data     Pointers to the data blocks */
+    const size_t* lengths,                              /** @param lengths  Lengths of the data blocks */
+    T* crcs,                                            /** @param crcs     Computed CRCs */
+    size_t count,                                       /** @param count    Number of data blocks */
+    T seed                                              /** @param seed     Seed of every block */
+)
+{
+    const uint8_t* ptr[S];
+    size_t left[S];
+    size_t slot[S];                                     // Block in each lane; count if the lane is empty
+    T crc[S];
+    size_t next = 0;
+    for (unsigned lane = 0; lane < S; ++lane)
+    {
+        ptr[lane] = nullptr;
+        left[lane] = 0;
+        slot[lane] = count;
+        crc[lane] = seed;
+    }
+
+    for (bool full = true; full; )
+    {
+        for (unsigned lane = 0; lane < S; ++lane)
+            while (left[lane] < N && slot[lane] != count + 1)
+            {
+                if (slot[lane] != count)                // Block finished: its tail is shorter than a step
+                    crcs[slot[lane]] = sliceCompute<T, dir, 1>(tables, ptr[lane], left[lane], crc[lane]);
+                if (next == count)
+                {
+                    slot[lane] = count + 1;             // No more blocks
+                    full = false;
+                    break;
+                }
+                slot[lane] = next;
+                ptr[lane] = data[next];
+                left[lane] = lengths[next];
+                crc[lane] = seed;
+                ++next;
+            }
+        if (!full)
+            break;
+
+        size_t steps = left[0] / N;
+        for (unsigned lane = 1; lane < S; ++lane)
+            steps = std::min(steps, left[lane] / N);
+        for (size_t step = 0; step < steps; ++step)
+        {
+            LIBCRC_UNROLL
+            for (unsigned lane = 0; lane < S; ++lane)
+                crc[lane] = sliceStep<T, dir, N>(tables, ptr[lane] + step * N, crc[lane]);
+        }
+        for (unsigned lane = 0; lane < S; ++lane)
+        {
+            ptr[lane] += steps * N;
+            left[lane] -= steps * N;
+        }
+    }
+
+    for (unsigned lane = 0; lane < S; ++lane)
+        if (slot[lane] < count)
+            crcs[slot[lane]] = sliceCompute<T, dir, N>(tables, ptr[lane], left[lane], crc[lane]);
+}
+
+/**
+ * @brief     Computes the CRCs of several data blocks of the same length, S at a time in lockstep.
+ */
+template <typename T, ShiftDir dir, unsigned N, unsigned S>
+void
+sliceBatch(
+    const T (*tables)[256],                             /** @param tables   N lookup tables */
+    const uint8_t* const* data,                         /** @param data     Pointers to the data blocks */
+    size_t length,                                      /** @param length   Length of every data block */
+    T* crcs,                                            /** @param crcs     Computed CRCs */
+    size_t count,                                       /** @param count    Number of data blocks */
+    T seed                                              /** @param seed     Seed of every block */
+)
+{
+    size_t first = 0;
+    for (; first + S <= count; first += S)
+    {
+        T crc[S];
+        for (unsigned lane = 0; lane < S; ++lane)
+            crc[lane] = seed;
+        size_t pos = 0;
+        for (; pos + N <= length; pos += N)
+        {
+            LIBCRC_UNROLL
+            for (unsigned lane = 0; lane < S; ++lane)
+                crc[lane] = sliceStep<T, dir, N>(tables, data[first + lane] + pos, crc[lane]);
+        }
+        for (; pos < length; ++pos)
+        {
+            LIBCRC_UNROLL
+            for (unsigned lane = 0; lane < S; ++lane)
+                crc[lane] = tableStep<T, dir>(tables[0], crc[lane], data[first + lane][pos]);
+        }
+        for (unsigned lane = 0; lane < S; ++lane)
+            crcs[first + lane] = crc[lane];
+    }
+    for (; first < count; ++first)
+        crcs[first] = sliceCompute<T, dir, N>(tables, data[first], length, seed);
+}
+
+/** ----------------------------------------------------
+ * @brief     Auxiliary functions: arithmetic modulo the CRC polynomial.
+ * @desc      Values are polynomials of degree lower than the register size, with the bits arranged as in the register:
+ *            the highest degree in the most significant bit for left shifting, in the least significant bit for right
+ *            shifting. Processing n zero bytes multiplies the register by x^(8 * n), which is what joins CRCs.
+ * ------ */
+/**
+ * @brief     Container of the powers x^(8 * 2^k) mod P, k = 0..63.
+ */
+template <typename T>
+struct PowerTable
+{
+    T power[64];                                        //!< Powers of x
+};
+
+/**
+ * @brief     Multiplies two polynomials modulo the polynomial of the CRC.
+ */
+template <typename T, ShiftDir dir>
+constexpr T                                             /** @return a * b mod P */
+multiplyMod(
+    T a,                                                /** @param a           First factor */
+    T b,                                                /** @param b           Second factor */
+    T polynomial                                        /** @param polynomial  Polynomial, already reversed for right shifting */
+)
+{
+    constexpr unsigned reg_bits = sizeof(T) * 8;
+    const T top = (dir == shiftLeft)? T(T(1) << (reg_bits - 1)) : T(1);
+    T result = 0;
+    for (unsigned bit = 0; bit < reg_bits; ++bit)       // Horner's rule, from the highest degree coefficient of a
+    {
+        T carry = (result & top)? polynomial : T(0);
+        result = Shifter<T, dir>().shift(result, 1) ^ carry;
+        T coefficient = (dir == shiftLeft)? T(a >> (reg_bits - 1 - bit)) : T(a >> bit);
+        result ^= b & T(0 - (coefficient & 1));
+    }
+    return result;
+}
+
+/**
+ * @brief     Builds the table of powers x^(8 * 2^k) mod P.
+ */
+template <typename T, ShiftDir dir>
+constexpr PowerTable<T>                                 /** @return Table of powers */
+makePowerTable(
+    T poly                                              /** @param poly  Polynomial, as given to the constructors */
+)
+{
+    PowerTable<T> table = {};
+    const T polynomial = (dir == shiftLeft)? poly : libcrc::reverse(poly);
+    const T one = (dir == shiftLeft)? T(1) : T(T(1) << (sizeof(T) * 8 - 1));
+    table.power[0] = divideByte<T, dir>(one, polynomial);       // x^8
+    for (unsigned k = 1; k < 64; ++k)
+        table.power[k] = multiplyMod<T, dir>(table.power[k - 1], table.power[k - 1], polynomial);
+    return table;
+}
+
+/**
+ * @brief     Moves a register forward as if a number of zero bytes were processed: crc * x^(8 * bytes) mod P.
+ */
+template <typename T, ShiftDir dir>
+constexpr T                                             /** @return Register after the zero bytes */
+shiftMod(
+    T crc,                                              /** @param crc         Register */
+    uint64_t bytes,                                     /** @param bytes       Number of zero bytes */
+    const T* powers,                                    /** @param powers      Table of powers x^(8 * 2^k) mod P */
+    T polynomial                                        /** @param polynomial  Polynomial, already reversed for right shifting */
+)
+{
+    for (unsigned k = 0; bytes != 0; ++k, bytes >>= 1)
+        if (bytes & 1)
+            crc = multiplyMod<T, dir>(crc, powers[k], polynomial);
+    return crc;
+}
+
+/** ----------------------------------------------------
+ * @brief     Where a calculator keeps its lookup tables.
+ * ------ */
+enum TableStorage
+{
+    tablesShared,                                       //!< In TableRegistry, shared by the calculators of the polynomial until the program ends
+    tablesOwned                                         //!< In the calculator and its copies, freed with the last of them; not registered,
+                                                        //!< aligned as set by TableRegistry::setPlacement but neither packed nor replicated
+};
+
+/** ----------------------------------------------------
+ * @brief     Class TableRegistry: Process-wide store of lookup tables.
+ * @desc      Lookup tables and tables of powers of x are identified by register size, shift direction and polynomial.
+ *            They are built on the first request and shared by every calculator using them, so calculators are small
+ *            handles and building one more costs a lookup. Tables are immutable, aligned to a cache line and valid until the program ends.
+ *            Where they are placed in memory is set with setPlacement (see Placement). All the functions are thread safe.
+ * ------ */
+class TableRegistry
+{
+public:
+    static constexpr size_t alignment = 64;             //!< Minimum alignment of the tables, in bytes: a cache line
+
+    /**
+     * @brief     Placement of the tables in memory.
+     * @desc      By default every set of tables has its own allocation. Packed, they are laid out one after the other
+     *            in large blocks, so that the tables of the polynomials in use together stay compact instead of being
+     *            scattered through the heap. With NUMA replicas (Linux only), the tables are copied to memory of the
+     *            NUMA node of the thread asking for them, so a calculator built on a thread uses the copy local to
+     *            it: parallel computations should then build one calculator per thread. Replicas are packed in blocks
+     *            of whole pages bound to their node; if the binding fails, pages still land on it by first touch.
+     *            The tables of powers are not replicated.
+     */
+    struct Placement
+    {
+        size_t alignment = TableRegistry::alignment;    //!< Alignment of the tables: a power of two, at least a cache line
+        bool packed = false;                            //!< Tables one after the other in large blocks
+        bool numa_replicas = false;                     //!< One copy of the lookup tables in each NUMA node
+    };
+
+    /**
+     * @brief     Sets the placement of the tables built from now on. The ones already built stay where they are.
+     */
+    static void
+    setPlacement(
+        const Placement& placement                      /** @param placement  Placement of the tables */
+    )
+    {
+        TableRegistry& registry = instance();
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        registry.placement_ = placement;
+        if (registry.placement_.alignment < alignment || (registry.placement_.alignment & (registry.placement_.alignment - 1)) != 0)
+            registry.placement_.alignment = alignment;
+    };
+
+    /**
+     * @brief     Provides the placement of the tables.
+     */
+    static Placement                                    /** @return Placement of the tables */
+    getPlacement()
+    {
+        TableRegistry& registry = instance();
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        return registry.placement_;
+    };
+
+    /**
+     * @brief     NUMA node of the CPU running the calling thread.
+     */
+    static unsigned                                     /** @return Node number; 0 if unknown or not Linux */
+    numaNode()
+    {
+        unsigned cpu = 0;
+        unsigned node = 0;
+#if defined(LIBCRC_NUMA) && defined(SYS_getcpu)
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+            node = 0;
+#endif
+        (void) cpu;
+        return node;
+    };
+
+    /**
+     * @brief     Provides the lookup tables of a polynomial, building them if needed.
+     * @desc      Table k holds the CRC of every byte value followed by k zero bytes. Tables are stored one after the
+     *            other; when more tables than the ones already built are requested, the whole set is built again.
+     */
+    template <typename T, ShiftDir dir>
+    static const T*                                     /** @return Pointer to at least `slices` consecutive tables of 256 entries */
+    get(
+        T poly,                                         /** @param poly    Polynomial, as given to the constructors */
+        unsigned slices = 1                             /** @param slices  Number of tables required */
+    )
+    {
+        TableRegistry& registry = instance();
+        const Key key = makeKey<T, dir>(poly);
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        const int node = registry.placement_.numa_replicas? int(numaNode()) : -1;
+        Entry& entry = registry.tables_[key];
+        if (entry.slices < slices)
+        {
+            T (*tables)[256] = static_cast<T (*)[256]>(registry.allocate(slices * sizeof(T[256]), node));
+            fillLookupTables<T, dir>(poly, tables, slices);
+            entry.data = tables;
+            entry.slices = slices;
+            entry.replicas.clear();
+            if (node >= 0)
+                entry.replica(node) = tables;
+        }
+        if (node >= 0)
+        {
+            const void*& replica = entry.replica(node);
+            if (replica == nullptr)
+            {
+                void* copy = registry.allocate(entry.slices * sizeof(T[256]), node);
+                memcpy(copy, entry.data, entry.slices * sizeof(T[256]));
+                replica = copy;
+            }
+            return static_cast<const T*>(replica);
+        }
+        return static_cast<const T*>(entry.data);
+    }
+
+    /**
+     * @brief     Builds lookup tables without registering them, for the calculators owning their tables.
+     * @desc      Laid out as get() returns them, with the alignment of the placement; they are neither packed nor
+     *            replicated in NUMA nodes. The lock is only taken to read the alignment.
+     */
+    template <typename T, ShiftDir dir>
+    static std::shared_ptr<const T>                     /** @return `slices` consecutive tables of 256 entries, freed with the last owner */
+    build(
+        T poly,                                         /** @param poly    Polynomial, as given to the constructors */
+        unsigned slices = 1                             /** @param slices  Number of tables */
+    )
+    {
+        const size_t align = getPlacement().alignment;
+        const size_t bytes = size_t(slices) * sizeof(T[256]);
+        std::shared_ptr<uint8_t> block(new uint8_t[bytes + align - 1], std::default_delete<uint8_t[]>());
+        T* tables = reinterpret_cast<T*>(alignUp(block.get(), align));
+        fillLookupTables<T, dir>(poly, reinterpret_cast<T (*)[256]>(tables), slices);
+        return std::shared_ptr<const T>(block, tables);
+    }
+
+    /**
+     * @brief     Provides the table of powers x^(8 * 2^k) mod P of a polynomial, building it if needed.
+     */
+    template <typename T, ShiftDir dir>
+    static const T*                                     /** @return Pointer to the 64 powers */
+    getPowers(
+        T poly                                          /** @param poly    Polynomial, as given to the constructors */
+    )
+    {
+        TableRegistry& registry = instance();
+        const Key key = makeKey<T, dir>(poly);
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        Entry& entry = registry.tables_[key];
+        if (entry.powers == nullptr)
+        {
+            PowerTable<T>* powers = static_cast<PowerTable<T>*>(registry.allocate(sizeof(PowerTable<T>)));
+            *powers = makePowerTable<T, dir>(poly);
+            entry.powers = powers->power;
+        }
+        return static_cast<const T*>(entry.powers);
+    }
+
+    /**
+     * @brief     Registers tables built elsewhere, such as the constexpr ones generated by test_libcrc++ -t header.
+     * @desc      Calculators built afterwards for the polynomial use them instead of building their own. The tables
+     *            must be the ones of the polynomial, laid out as get() returns them, and valid until the program ends;
+     *            they replace the registered ones only if these have fewer slices or there are none.
+     */
+    template <typename T, ShiftDir dir>
+    static void
+    preload(
+        T poly,                                         /** @param poly    Polynomial, as given to the constructors */
+        const T* tables,                                /** @param tables  Consecutive lookup tables of 256 entries, or nullptr */
+        unsigned slices,                                /** @param slices  Number of tables */
+        const T* powers = nullptr                       /** @param powers  The 64 powers x^(8 * 2^k) mod P, or nullptr */
+    )
+    {
+        TableRegistry& registry = instance();
+        const Key key = makeKey<T, dir>(poly);
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        Entry& entry = registry.tables_[key];
+        if (tables != nullptr && entry.slices < slices)
+        {
+            entry.data = tables;
+            entry.slices = slices;
+            entry.replicas.clear();
+        }
+        if (powers != nullptr && entry.powers == nullptr)
+            entry.powers = powers;
+    }
+
+    /**
+     * @brief     Number of table sets in the registry.
+     */
+    static size_t                                       /** @return Number of polynomials with tables built */
+    size()
+    {
+        TableRegistry& registry = instance();
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        return registry.tables_.size();
+    };
+
+private:
+    struct Key
+    {
+        unsigned bits;                                  //!< Register size, in bits
+        ShiftDir dir;                                   //!< Shift direction
+        uint64_t poly;                                  //!< Polynomial, low 64 bits
+        uint64_t poly_high;                             //!< Polynomial, bits above the 64th ones
+
+        bool operator==(const Key& other) const
+        {
+            return bits == other.bits && dir == other.dir && poly == other.poly && poly_high == other.poly_high;
+        };
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<uint64_t>()(key.poly ^ key.poly_high * 0x9E3779B97F4A7C15 ^ (uint64_t(key.bits * 2 + key.dir) << 56));
+        };
+    };
+
+    /**
+     * @brief     Key of a polynomial.
+     */
+    template <typename T, ShiftDir dir>
+    static Key
+    makeKey(
+        T poly                                          /** @param poly    Polynomial, as given to the constructors */
+    )
+    {
+        const unsigned high = (sizeof(T) > sizeof(uint64_t))? 64 : 0;  // Only registers wider than 64 bits have them
+        return { unsigned(sizeof(T) * 8), dir, uint64_t(poly), high? uint64_t(poly >> high) : 0 };
+    }
+
+    struct Entry
+    {
+        const void* data = nullptr;                     //!< Tables
+        unsigned slices = 0;                            //!< Number of tables
+        const void* powers = nullptr;                   //!< Powers of x used to join CRCs
+        std::vector<const void*> replicas;              //!< Copies of the tables by NUMA node; nullptr if not made
+
+        const void*& replica(int node)
+        {
+            if (replicas.size() <= size_t(node))
+                replicas.resize(size_t(node) + 1, nullptr);
+            return replicas[size_t(node)];
+        };
+    };
+
+    struct Arena
+    {
+        uint8_t* next = nullptr;                        //!< First free byte of the current block
+        size_t left = 0;                                //!< Free bytes in the current block
+    };
+
+    static constexpr size_t arena_block_ = size_t(256) << 10;     //!< Size of the blocks of packed tables
+
+    /**
+     * @brief     The registry itself, created on first use.
+     */
+    static TableRegistry&
+    instance()
+    {
+        static TableRegistry registry;
+        return registry;
+    };
+
+    /**
+     * @brief     Allocates memory for tables as set by the placement, owned by the registry.
+     */
+    void*
+    allocate(
+        size_t bytes,                                   /** @param bytes  Size of the tables */
+        int node = -1                                   /** @param node   NUMA node to place them in; -1 for any */
+    )
+    {
+        const size_t align = placement_.alignment;
+        if (!placement_.packed && node < 0)
+            return alignUp(newBlock(bytes + align - 1), align);
+
+        if (arenas_.size() <= size_t(node + 1))
+            arenas_.resize(size_t(node + 1) + 1);
+        Arena& arena = arenas_[size_t(node + 1)];
+        uint8_t* start = alignUp(arena.next, align);
+        if (arena.next == nullptr || size_t(start - arena.next) + bytes > arena.left)
+        {
+            const size_t page = pageSize();             // Blocks of whole pages, so that no other data shares them
+            const size_t size = (((bytes + align > arena_block_)? bytes + align : arena_block_) + page - 1) & ~(page - 1);
+            arena.next = alignUp(newBlock(size + page - 1), page);
+            arena.left = size;
+            if (node >= 0)
+                bindToNode(arena.next, size, unsigned(node));
+            start = alignUp(arena.next, align);
+        }
+        arena.left -= size_t(start - arena.next) + bytes;
+        arena.next = start + bytes;
+        return start;
+    };
+
+    /**
+     * @brief     Allocates memory owned by the registry.
+     */
+    uint8_t*                                            /** @return Allocated memory */
+    newBlock(
+        size_t bytes                                    /** @param bytes  Size */
+    )
+    {
+        blocks_.emplace_back(new uint8_t[bytes]);
+        return blocks_.back().get();
+    };
+
+    static uint8_t*                                     /** @return First address at or after `address` with the alignment */
+    alignUp(
+        uint8_t* address,                               /** @param address  Address */
+        size_t align                                    /** @param align    Alignment, a power of two */
+    )
+    {
+        return reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(address) + align - 1) & ~uintptr_t(align - 1));
+    };
+
+    static size_t                                       /** @return Size of the memory pages */
+    pageSize()
+    {
+#if defined(LIBCRC_NUMA)
+        const long page = sysconf(_SC_PAGESIZE);
+        if (page > 0)
+            return size_t(page);
+#endif
+        return 4096;
+    };
+
+    /**
+     * @brief     Asks the kernel to place pages in a NUMA node and move them there if needed. Best effort.
+     */
+    static void
+    bindToNode(
+        void* address,                                  /** @param address  First page, aligned to a page */
+        size_t bytes,                                   /** @param bytes    Size, in whole pages */
+        unsigned node                                   /** @param node     NUMA node */
+    )
+    {
+#if defined(LIBCRC_NUMA) && defined(SYS_mbind)
+        const unsigned long mpol_preferred = 1;         // From linux/mempolicy.h, to avoid depending on libnuma
+        const unsigned long mpol_mf_move = 1 << 1;
+        const unsigned word_bits = sizeof(unsigned long) * 8;
+        std::vector<unsigned long> nodes(node / word_bits + 1, 0);
+        nodes[node / word_bits] |= 1ul << (node % word_bits);
+        syscall(SYS_mbind, address, bytes, mpol_preferred, nodes.data(), nodes.size() * word_bits + 1, mpol_mf_move);
+#endif
+        (void) address;
+        (void) bytes;
+        (void) node;
+    };
+
+    std::mutex mutex_;                                  //!< Protects the members below
+    Placement placement_;                               //!< Placement of the tables built from now on
+    std::unordered_map<Key, Entry, KeyHash> tables_;    //!< Tables by polynomial
+    std::vector<Arena> arenas_;                         //!< Blocks of packed tables: any node first, then by NUMA node
+    std::vector<std::unique_ptr<uint8_t[]>> blocks_;    //!< Memory of the tables, including replaced ones
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcBase: Register setup common to all the CRC calculators.
+ * ------ */
+template <typename T, ShiftDir dir>
+class CrcBase
+{
+public:
+    static constexpr ShiftDir direction = dir;          //!< Shift direction of the register
+
+    /**
+     * @brief     Computes the CRC of the concatenation of two data blocks from the CRCs of both blocks.
+     * @desc      crcA is the CRC of the first block, computed with any seed; that seed is also the seed of the result.
+     *            crcB is the CRC of the second block, computed with seedB. Runs in O(log lengthB).
+     */
+    T                                                   /** @return CRC of A followed by B */
+    combine(
+        T crcA,                                         /** @param crcA     CRC of the first block */
+        T crcB,                                         /** @param crcB     CRC of the second block */
+        uint64_t lengthB,                               /** @param lengthB  Length of the second block */
+        T seedB = 0                                     /** @param seedB    Seed used to compute crcB */
+    ) const
+    {
+        return crcB ^ shiftMod<T, dir>(crcA ^ seedB, lengthB, powers(), polynomial_);
+    };
+
+    /**
+     * @brief     Updates the CRC of a data block after some bytes inside it have been replaced.
+     * @desc      The CRC is linear: the new CRC is the old one plus the CRC, with seed 0, of the changed bits followed by
+     *            the bytes after them. Only the replaced bytes are read and it runs in O(count + log length), whatever
+     *            the seed. offset + count must not exceed length.
+     */
+    T                                                   /** @return CRC of the modified block */
+    update(
+        T crc,                                          /** @param crc       CRC of the original block */
+        uint64_t length,                                /** @param length    Length of the block */
+        uint64_t offset,                                /** @param offset    Position of the replaced bytes */
+        const uint8_t* oldData,                         /** @param oldData   Original bytes */
+        const uint8_t* newData,                         /** @param newData   Bytes replacing them */
+        size_t count                                    /** @param count     Number of replaced bytes */
+    ) const
+    {
+        T delta = 0;
+        for (size_t idx = 0; idx < count; ++idx)
+            delta = divideByte(delta ^ (T(oldData[idx] ^ newData[idx]) << pack_));
+        return crc ^ shiftMod<T, dir>(delta, length - offset - count, powers(), polynomial_);
+    };
+
+protected:
+    /**
+     * @brief     Constructor. Prepares the polynomial according to the shift direction.
+     */
+    CrcBase(
+      T poly                                            /** @param poly Polynomial to use for the computation */
+    ) : shifter_(),
+        polynomial_(dir == shiftLeft? poly : libcrc::reverse(poly)),
+        mask_(dir == shiftLeft? (T(1) << ((sizeof(T) * 8) - 1)) : 1),
+        pack_(dir == shiftLeft? ((sizeof(T) - 1) * 8) : 0),
+        powers_(nullptr)
+    { };
+
+    /**
+     * @brief     Copy constructor. The copy shares the powers of x, if they have been got already.
+     */
+    CrcBase(
+      const CrcBase& other                              /** @param other Calculator to copy */
+    ) : shifter_(),
+        polynomial_(other.polynomial_),
+        mask_(other.mask_),
+        pack_(other.pack_),
+        powers_(other.powers_.load(std::memory_order_acquire))
+    { };
+
+    /**
+     * @brief     Provides the powers of x used to join CRCs. They are got from the registry on first use, so the
+     *            calculators that never join nor update CRCs do not build them.
+     */
+    const T*                                            /** @return Table of powers x^(8 * 2^k) mod P */
+    powers() const
+    {
+        const T* table = powers_.load(std::memory_order_acquire);
+        if (table == nullptr)
+        {
+            table = TableRegistry::getPowers<T, dir>(dir == shiftLeft? polynomial_ : libcrc::reverse(polynomial_));
+            powers_.store(table, std::memory_order_release);    // Racing threads store the same registry pointer
+        }
+        return table;
+    };
+
+    /**
+     * @brief     Shifts the eight bits of a byte through the register, applying the polynomial bit by bit.
+     */
+    T                                                   /** @return Register after processing the byte */
+    divideByte(
+        T result                                        /** @param result  Register with the byte already added */
+    ) const
+    {
+        return libcrc::divideByte<T, dir>(result, polynomial_);
+    };
+
+    Shifter<T, dir> shifter_;                           //!< Bit shifter
+    T polynomial_;                                      //!< Polynomial used in the CRC computation
+    const T   mask_;                                    //!< Bit mask with the next bit to be processed according to the processing direction set to 1
+    const int pack_;                                    //!< Number of bits to shift to pack a byte inside a word
+    mutable std::atomic<const T*> powers_;              //!< Powers of x to join CRCs, shared through the registry; nullptr until used
+};
+
+#if __cplusplus < 201703L
+template <typename T, ShiftDir dir>
+constexpr ShiftDir CrcBase<T, dir>::direction;
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Class CrcCalc: CRC calculator without table.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcCalc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Initializes to zero.
+     */
+    CrcCalc(
+      T poly                                            /** @param poly Polynomial to use for the computation */
+    ) : CrcBase<T, dir>(poly)
+    { };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+        const uint8_t* data,                            /** @param data    Pointer to the data block to compute CRC */
+        size_t length,                                  /** @param length  Data length */
+        T seed = 0                                      /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        LIBCRC_STATS_SCOPE(engineBitwise, length);
+        T result = seed;
+        while (length--)
+            result = this->divideByte(result ^ (T(*data++) << this->pack_));
+        return result;
+    };
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcNibbleCalc: CRC calculator with a 16-entry lookup table, processing a byte in two 4-bit steps.
+ * @desc      The table takes 16 registers (128 bytes for a 64-bit CRC) and is held by the calculator itself. About
+ *            half the speed of CrcFastCalc, for targets without room for a 256-entry table. Nothing is allocated nor
+ *            registered in TableRegistry unless combine() or update() are called (see CrcBase::powers).
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcNibbleCalc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Initializes the lookup table.
+     */
+    CrcNibbleCalc(
+      T poly                                            /** @param poly Polynomial to use for the computation */
+    ) : CrcBase<T, dir>(poly)
+    {
+        const int pack = (dir == shiftLeft)? (sizeof(T) * 8 - 4) : 0;
+        for (unsigned idx = 0; idx < 16; ++idx)
+        {
+            T result = T(T(idx) << pack);
+            for (int bit = 4; bit > 0; --bit)
+                result = (result & this->mask_)? T(this->shifter_.shift(result, 1) ^ this->polynomial_) : this->shifter_.shift(result, 1);
+            table_[idx] = result;
+        }
+    };
+
+    /**
+     * @brief     Provides a pointer to the lookup table.
+     */
+    const T*                                            /** @return Precalculated lookup table, 16 entries */
+    getLookupTable() const
+    {
+        return table_;
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        LIBCRC_STATS_SCOPE(engineNibble, length);
+        const int top = (dir == shiftLeft)? (sizeof(T) * 8 - 4) : 0;
+        T result = seed;
+        while (length--)
+        {
+            result ^= T(T(*data++) << this->pack_);
+            result = this->shifter_.shift(result, 4) ^ table_[(result >> top) & 0xf];
+            result = this->shifter_.shift(result, 4) ^ table_[(result >> top) & 0xf];
+        }
+        return result;
+    };
+
+private:
+    T table_[16];                                       //!< CRC of every nibble value
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcFastCalc: CRC calculador with lookup table.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcFastCalc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Gets the precalculated table from the registry, or builds its own.
+     * @desc      tablesOwned suits short-lived calculators of many polynomials, such as polynomial searches: no lock is
+     *            taken and the table is freed with the calculator and its copies.
+     */
+    CrcFastCalc(
+      T poly,                                           /** @param poly     Polynomial to use for the computation */
+      TableStorage storage = tablesShared               /** @param storage  Where the table is kept */
+    ) : CrcBase<T, dir>(poly),
+        owned_((storage == tablesOwned)? TableRegistry::build<T, dir>(poly) : nullptr),
+        lookup_table_(owned_? owned_.get() : TableRegistry::get<T, dir>(poly))
+    { };
+
+    /**
+     * @brief     Provides a pointer to the lookup table.
+     */
+    const T*                                            /** @return Precalculated lookup table */
+    getLookupTable() const
+    {
+        return lookup_table_;
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        LIBCRC_STATS_SCOPE(engineTable, length);
+        T result = seed;
+        while (length--)
+            result = this->shifter_.shift(result, 8) ^ lookup_table_[((result >> this->pack_) ^ (*data++)) & 0xff];
+        return result;
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks, interleaving 8 of them to overlap their lookups.
+     */
+    void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      const size_t* lengths,                            /** @param lengths  Lengths of the data blocks */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    ) const
+    {
+        sliceBatch<T, dir, 1, 8>(reinterpret_cast<const T (*)[256]>(lookup_table_), data, lengths, crcs, count, seed);
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks of the same length, 8 at a time in lockstep.
+     */
+    void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      size_t length,                                    /** @param length   Length of every data block */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    ) const
+    {
+        sliceBatch<T, dir, 1, 8>(reinterpret_cast<const T (*)[256]>(lookup_table_), data, length, crcs, count, seed);
+    };
+
+private:
+    std::shared_ptr<const T> owned_;                    //!< Own table, with tablesOwned
+    const T* lookup_table_;                             //!< Precalculated lookup table, shared through the registry or owned
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcSlicingCalc: CRC calculator with N lookup tables ("slicing-by-N").
+ * @desc      Table k holds the CRC of every byte value followed by k zero bytes, so a block of N bytes is reduced with
+ *            N independent lookups instead of a chain of N dependent ones. The data is read a word at a time.
+ *            Results are identical to CrcFastCalc for the same polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, unsigned N = 8, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcSlicingCalc : public CrcBase<T, dir>
+{
+    static_assert(N == 4 || N == 8 || N == 16, "Slicing is supported for 4, 8 or 16 tables");
+
+public:
+    /**
+     * @brief     Constructor. Gets the precalculated tables from the registry, or builds its own (see CrcFastCalc).
+     */
+    CrcSlicingCalc(
+      T poly,                                           /** @param poly     Polynomial to use for the computation */
+      TableStorage storage = tablesShared               /** @param storage  Where the tables are kept */
+    ) : CrcBase<T, dir>(poly),
+        owned_((storage == tablesOwned)? TableRegistry::build<T, dir>(poly, N) : nullptr),
+        lookup_table_(reinterpret_cast<const T (*)[256]>(owned_? owned_.get() : TableRegistry::get<T, dir>(poly, N)))
+    { };
+
+    /**
+     * @brief     Provides a pointer to the lookup tables.
+     * @desc      The first 256 entries are the table used by CrcFastCalc; table k starts at entry k * 256.
+     */
+    const T*                                            /** @return Precalculated lookup tables */
+    getLookupTable() const
+    {
+        return lookup_table_[0];
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        LIBCRC_STATS_SCOPE(engineSlicing, length);
+        return sliceCompute<T, dir, N>(lookup_table_, data, length, seed);
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks, interleaving 4 of them to overlap their lookups.
+     */
+    void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      const size_t* lengths,                            /** @param lengths  Lengths of the data blocks */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    ) const
+    {
+        sliceBatch<T, dir, N, 4>(lookup_table_, data, lengths, crcs, count, seed);
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks of the same length, 4 at a time in lockstep.
+     */
+    void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      size_t length,                                    /** @param length   Length of every data block */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    ) const
+    {
+        sliceBatch<T, dir, N, 4>(lookup_table_, data, length, crcs, count, seed);
+    };
+
+private:
+    std::shared_ptr<const T> owned_;                    //!< Own tables, with tablesOwned
+    const T (*lookup_table_)[256];                      //!< Precalculated lookup tables, shared through the registry or owned
+};
+
+/** ----------------------------------------------------
+ * @brief     Class RollingCrc: CRC of a window of fixed length that slides over the data one byte at a time.
+ * @desc      The CRC is linear, so the CRC of the window moved one byte forward is the CRC of the window plus the new
+ *            byte, minus the contribution of the byte that leaves it: the CRC of that byte followed by as many zero
+ *            bytes as the window is long. These contributions are kept in a table, one entry for each byte value, so
+ *            every move costs two lookups whatever the length of the window. Results are identical to those of
+ *            CrcFastCalc on each window for the same polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class RollingCrc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Builds the table of the bytes leaving the window.
+     */
+    RollingCrc(
+      T poly,                                           /** @param poly    Polynomial to use for the computation */
+      size_t window,                                    /** @param window  Length of the window, in bytes */
+      T seed = 0                                        /** @param seed    Seed of the CRC of every window */
+    ) : CrcBase<T, dir>(poly),
+        lookup_table_(TableRegistry::get<T, dir>(poly)),
+        window_(window),
+        out_table_(256)
+    {
+        const T one = (dir == shiftLeft)? T(1) : T(T(1) << (sizeof(T) * 8 - 1));
+        const T shift = shiftMod<T, dir>(one, window, this->powers(), this->polynomial_);   // x^(8 * window)
+        for (unsigned idx = 0; idx < 256; ++idx)
+            out_table_[idx] = multiplyMod<T, dir>(lookup_table_[idx], shift, this->polynomial_);
+        seed_term_ = multiplyMod<T, dir>(seed, shift, this->polynomial_);
+    };
+
+    /**
+     * @brief     Provides the length of the window.
+     */
+    size_t                                              /** @return Length of the window, in bytes */
+    getWindow() const
+    {
+        return window_;
+    };
+
+    /**
+     * @brief     Computes the CRC of a window.
+     */
+    T                                                   /** @return CRC of the window */
+    compute(
+      const uint8_t* data                               /** @param data    Pointer to the first byte of the window */
+    ) const
+    {
+        T result = 0;
+        for (size_t idx = 0; idx < window_; ++idx)
+            result = tableStep<T, dir>(lookup_table_, result, data[idx]);
+        return result ^ seed_term_;
+    };
+
+    /**
+     * @brief     Moves the window one byte forward.
+     */
+    T                                                   /** @return CRC of the moved window */
+    roll(
+      T crc,                                            /** @param crc     CRC of the window */
+      uint8_t out,                                      /** @param out     First byte of the window, leaving it */
+      uint8_t in                                        /** @param in      Byte following the window, entering it */
+    ) const
+    {
+        return tableStep<T, dir>(lookup_table_, crc ^ seed_term_, in) ^ out_table_[out] ^ seed_term_;
+    };
+
+    /**
+     * @brief     Slides the window over a data block until the CRC of the window satisfies a condition.
+     * @desc      Typical use is content-defined chunking: a chunk ends where pred(crc) is true, and the scan goes on
+     *            from there. The first window is the one at the beginning of the block. Moving a window is a chain of
+     *            dependent lookups, so the block is scanned in spans of several consecutive stretches, each one with
+     *            its own window, moved in lockstep. pred is therefore called out of order and must have no side effects.
+     */
+    template <typename Pred>
+    size_t                                              /** @return End of the first window satisfying pred, or length */
+    scan(
+      const uint8_t* data,                              /** @param data    Pointer to the data block */
+      size_t length,                                    /** @param length  Data length */
+      Pred pred                                         /** @param pred    Condition, called with the CRC of each window */
+    ) const
+    {
+        if (length < window_)
+            return length;
+        const size_t stride = std::max(size_t(256), 4 * window_);          // Window ends tested by each lane
+        size_t end = window_;                                               // End of the next window to test
+        for (; length - end >= lanes_ * stride; end += lanes_ * stride)
+        {
+            T result[lanes_];
+            size_t found[lanes_];
+            LIBCRC_UNROLL
+            for (unsigned lane = 0; lane < lanes_; ++lane)
+            {
+                result[lane] = 0;
+                found[lane] = length;
+            }
+            const uint8_t* start = data + end - window_;
+            for (size_t idx = 0; idx < window_; ++idx)
+            {
+                LIBCRC_UNROLL
+                for (unsigned lane = 0; lane < lanes_; ++lane)
+                    result[lane] = tableStep<T, dir>(lookup_table_, result[lane], start[lane * stride + idx]);
+            }
+            for (size_t idx = 0; idx < stride; ++idx)
+            {
+                LIBCRC_UNROLL
+                for (unsigned lane = 0; lane < lanes_; ++lane)
+                {
+                    const uint8_t* window = start + lane * stride + idx;
+                    if (found[lane] == length && pred(T(result[lane] ^ seed_term_)))
+                        found[lane] = end + lane * stride + idx;
+                    result[lane] = tableStep<T, dir>(lookup_table_, result[lane], window[window_]) ^ out_table_[window[0]];
+                }
+            }
+            for (unsigned lane = 0; lane < lanes_; ++lane)
+                if (found[lane] != length)
+                    return found[lane];
+        }
+
+        T result = compute(data + end - window_) ^ seed_term_;
+        for (; ; ++end)
+        {
+            if (pred(T(result ^ seed_term_)))
+                return end;
+            if (end == length)
+                return length;
+            result = tableStep<T, dir>(lookup_table_, result, data[end]) ^ out_table_[data[end - window_]];
+        }
+    }
+
+private:
+    const T* lookup_table_;                             //!< Precalculated lookup table, shared through the registry
+    static constexpr unsigned lanes_ = 4;               //!< Windows moved at the same time by scan()
+
+    size_t window_;                                     //!< Length of the window
+    std::vector<T> out_table_;                          //!< Contribution of each byte value leaving the window
+    T seed_term_;                                       //!< Contribution of the seed: seed * x^(8 * window) mod P
+};
+
+/** ----------------------------------------------------
+ * @brief     Struct ClmulConstants: Folding and reduction constants of the carry-less multiplication engine.
+ * @desc      The data is folded in 128-bit lanes: a lane L = H * x^64 + Lo moved d bits forward is congruent to
+ *            H * (x^(d+64) mod G) + Lo * (x^d mod G). In reflected (right shift) order every product carries an extra
+ *            factor x, so the exponents are one less and the values are bit-reversed.
+ * ------ */
+struct ClmulConstants
+{
+    static constexpr unsigned lanes = 8;                //!< Lanes folded in parallel
+    static constexpr unsigned wide_lanes = 16;          //!< Lanes folded in parallel by the AVX-512 engine
+
+    uint64_t fold_[wide_lanes][2];                      //!< Multipliers to fold a lane (i + 1) * 128 bits forward {low half, high half}
+    uint64_t final_;                                    //!< Multiplier to reduce the last lane to 128 bits
+    uint64_t barrett_;                                  //!< Barrett quotient floor(x^128 / G)
+    uint64_t poly_;                                     //!< Polynomial G without its x^64 term
+
+    /**
+     * @brief     Builds the constants for the given polynomial.
+     */
+    template <ShiftDir dir>
+    static ClmulConstants                               /** @return Constants, arranged for the shift direction */
+    make(
+        uint64_t g                                      /** @param g  Polynomial G without its x^64 term, normal order */
+    )
+    {
+        ClmulConstants k;
+        for (unsigned lane = 0; lane < wide_lanes; ++lane)
+        {
+            unsigned d = (lane + 1) * 128;
+            if (dir == shiftLeft)
+            {
+                k.fold_[lane][0] = xPowMod(d, g);
+                k.fold_[lane][1] = xPowMod(d + 64, g);
+            }
+            else
+            {
+                k.fold_[lane][0] = reverse(xPowMod(d + 63, g));
+                k.fold_[lane][1] = reverse(xPowMod(d - 1, g));
+            }
+        }
+        uint64_t mu = barrettQuotient(g);
+        if (dir == shiftLeft)
+        {
+            k.final_ = xPowMod(128, g);
+            k.barrett_ = mu;
+            k.poly_ = g;
+        }
+        else
+        {
+            k.final_ = reverse(xPowMod(127, g));
+            k.barrett_ = reverse((uint64_t(1) << 63) | (mu >> 1));  // floor(x^128 / G) / x, so that the product lands aligned
+            k.poly_ = reverse(g);
+        }
+        return k;
+    }
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcFastCalcT: CRC calculator with the polynomial as a template parameter.
+ * @desc      The N lookup tables (see CrcSlicingCalc) are built at compile time and stored in read-only memory, so
+ *            there is no construction cost and the compiler sees every parameter of the computation as a constant.
+ *            compute() can also be evaluated at compile time. Results are identical to CrcFastCalc for the same
+ *            polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, T poly, unsigned N = 8, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcFastCalcT
+{
+    static_assert(N == 1 || N == 4 || N == 8 || N == 16, "Slicing is supported for 1, 4, 8 or 16 tables");
+
+public:
+    static constexpr T polynomial = poly;               //!< Polynomial used in the CRC computation
+
+    /**
+     * @brief     Provides a pointer to the lookup tables.
+     * @desc      The first 256 entries are the table used by CrcFastCalc; table k starts at entry k * 256.
+     */
+    static constexpr const T*                           /** @return Precalculated lookup tables */
+    getLookupTable()
+    {
+        return tables_.table[0];
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    static constexpr T                                  /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    )
+    {
+        return sliceCompute<T, dir, N>(tables_.table, data, length, seed);
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks, interleaving 4 of them (8 with one table) to overlap lookups.
+     */
+    static void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      const size_t* lengths,                            /** @param lengths  Lengths of the data blocks */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    )
+    {
+        sliceBatch<T, dir, N, (N > 1)? 4 : 8>(tables_.table, data, lengths, crcs, count, seed);
+    };
+
+    /**
+     * @brief     Computes the CRCs of several data blocks of the same length, 4 (8 with one table) at a time in lockstep.
+     */
+    static void
+    computeBatch(
+      const uint8_t* const* data,                       /** @param data     Pointers to the data blocks */
+      size_t length,                                    /** @param length   Length of every data block */
+      T* crcs,                                          /** @param crcs     Computed CRCs, one for each block */
+      size_t count,                                     /** @param count    Number of data blocks */
+      T seed = 0                                        /** @param seed     Seed of every block */
+    )
+    {
+        sliceBatch<T, dir, N, (N > 1)? 4 : 8>(tables_.table, data, length, crcs, count, seed);
+    };
+
+    /**
+     * @brief     Computes the CRC of the concatenation of two data blocks from the CRCs of both blocks.
+     * @desc      See CrcBase::combine.
+     */
+    static constexpr T                                  /** @return CRC of A followed by B */
+    combine(
+        T crcA,                                         /** @param crcA     CRC of the first block */
+        T crcB,                                         /** @param crcB     CRC of the second block */
+        uint64_t lengthB,                               /** @param lengthB  Length of the second block */
+        T seedB = 0                                     /** @param seedB    Seed used to compute crcB */
+    )
+    {
+        return crcB ^ shiftMod<T, dir>(crcA ^ seedB, lengthB, powers_.power, (dir == shiftLeft)? poly : libcrc::reverse(poly));
+    };
+
+    /**
+     * @brief     Updates the CRC of a data block after some bytes inside it have been replaced.
+     * @desc      See CrcBase::update.
+     */
+    static constexpr T                                  /** @return CRC of the modified block */
+    update(
+        T crc,                                          /** @param crc       CRC of the original block */
+        uint64_t length,                                /** @param length    Length of the block */
+        uint64_t offset,                                /** @param offset    Position of the replaced bytes */
+        const uint8_t* oldData,                         /** @param oldData   Original bytes */
+        const uint8_t* newData,                         /** @param newData   Bytes replacing them */
+        size_t count                                    /** @param count     Number of replaced bytes */
+    )
+    {
+        T delta = 0;
+        for (size_t idx = 0; idx < count; ++idx)
+            delta = tableStep<T, dir>(tables_.table[0], delta, uint8_t(oldData[idx] ^ newData[idx]));
+        return crc ^ shiftMod<T, dir>(delta, length - offset - count, powers_.power, (dir == shiftLeft)? poly : libcrc::reverse(poly));
+    };
+
+private:
+    static constexpr LookupTables<T, N> tables_ = makeLookupTables<T, dir, N>(poly);   //!< Precalculated lookup tables
+    static constexpr PowerTable<T> powers_ = makePowerTable<T, dir>(poly);              //!< Powers of x to join CRCs
+};
+
+#if __cplusplus < 201703L
+template <typename T, ShiftDir dir, T poly, unsigned N, typename E>
+constexpr T CrcFastCalcT<T, dir, poly, N, E>::polynomial;
+template <typename T, ShiftDir dir, T poly, unsigned N, typename E>
+constexpr LookupTables<T, N> CrcFastCalcT<T, dir, poly, N, E>::tables_;
+template <typename T, ShiftDir dir, T poly, unsigned N, typename E>
+constexpr PowerTable<T> CrcFastCalcT<T, dir, poly, N, E>::powers_;
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Struct CrcModel: parameters of a CRC algorithm in the Rocksoft model.
+ * @desc      poly, init, xorout, check and residue are written as in the usual CRC catalogues: not reflected, with
+ *            the highest degree coefficient of the polynomial omitted. check is the CRC of "123456789"; residue is the
+ *            register after processing a data block followed by its CRC, reflected if refout, before the final XOR.
+ *            width may be smaller than the register type, as in CRC-5 or CRC-24; the values then have width bits.
+ * ------ */
+template <typename T, T poly_, T init_, bool refin_, bool refout_, T xorout_, T check_, T residue_,
+          unsigned width_ = sizeof(T) * 8>
+struct CrcModel
+{
+    static_assert(width_ > 0 && width_ <= sizeof(T) * 8, "The width of the CRC must fit in the register type");
+
+    using Type = T;                                     //!< Register type
+
+    static constexpr unsigned width = width_;           //!< Width of the CRC, in bits
+    static constexpr T poly = poly_;                    //!< Polynomial
+    static constexpr T init = init_;                    //!< Initial value of the register
+    static constexpr bool refin = refin_;               //!< The bytes are processed least significant bit first
+    static constexpr bool refout = refout_;             //!< The register is reflected before the final XOR
+    static constexpr T xorout = xorout_;                //!< Final XOR
+    static constexpr T check = check_;                  //!< CRC of "123456789"
+    static constexpr T residue = residue_;              //!< Register after a block followed by its CRC
+};
+
+#if __cplusplus < 201703L
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr unsigned CrcModel<T, p, i, ri, ro, x, c, r, w>::width;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr T CrcModel<T, p, i, ri, ro, x, c, r, w>::poly;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr T CrcModel<T, p, i, ri, ro, x, c, r, w>::init;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr bool CrcModel<T, p, i, ri, ro, x, c, r, w>::refin;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr bool CrcModel<T, p, i, ri, ro, x, c, r, w>::refout;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr T CrcModel<T, p, i, ri, ro, x, c, r, w>::xorout;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr T CrcModel<T, p, i, ri, ro, x, c, r, w>::check;
+template <typename T, T p, T i, bool ri, bool ro, T x, T c, T r, unsigned w>
+constexpr T CrcModel<T, p, i, ri, ro, x, c, r, w>::residue;
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Catalogue of standard CRC algorithms. Names follow the CRC RevEng catalogue.
+ * ------ */
+#define LIBCRC_MODEL_WIDTH(Name, label, T, width, poly, init, refin, refout, xorout, check, residue)                 \
+    struct Name : CrcModel<T, poly, init, refin, refout, xorout, check, residue, width>                             \
+    {                                                                                                               \
+        static constexpr const char* name() { return label; }                                                       \
+    }
+#define LIBCRC_MODEL(Name, label, T, poly, init, refin, refout, xorout, check, residue)                              \
+    LIBCRC_MODEL_WIDTH(Name, label, T, sizeof(T) * 8, poly, init, refin, refout, xorout, check, residue)
+
+LIBCRC_MODEL_WIDTH(Crc5Usb,   "CRC-5/USB",          uint8_t,  5,  0x05, 0x1F, true,  true,  0x1F, 0x19, 0x06);
+LIBCRC_MODEL(Crc8Smbus,       "CRC-8/SMBUS",        uint8_t,  0x07, 0x00, false, false, 0x00, 0xF4, 0x00);
+LIBCRC_MODEL(Crc8MaximDow,    "CRC-8/MAXIM-DOW",    uint8_t,  0x31, 0x00, true,  true,  0x00, 0xA1, 0x00);
+LIBCRC_MODEL(Crc8Autosar,     "CRC-8/AUTOSAR",      uint8_t,  0x2F, 0xFF, false, false, 0xFF, 0xDF, 0x42);
+LIBCRC_MODEL_WIDTH(Crc15Can,  "CRC-15/CAN",         uint16_t, 15, 0x4599, 0x0000, false, false, 0x0000, 0x059E, 0x0000);
+LIBCRC_MODEL(Crc16Arc,        "CRC-16/ARC",         uint16_t, 0x8005, 0x0000, true,  true,  0x0000, 0xBB3D, 0x0000);
+LIBCRC_MODEL(Crc16Modbus,     "CRC-16/MODBUS",      uint16_t, 0x8005, 0xFFFF, true,  true,  0x0000, 0x4B37, 0x0000);
+LIBCRC_MODEL(Crc16Usb,        "CRC-16/USB",         uint16_t, 0x8005, 0xFFFF, true,  true,  0xFFFF, 0xB4C8, 0xB001);
+LIBCRC_MODEL(Crc16Ibm3740,    "CRC-16/IBM-3740",    uint16_t, 0x1021, 0xFFFF, false, false, 0x0000, 0x29B1, 0x0000);
+LIBCRC_MODEL(Crc16Xmodem,     "CRC-16/XMODEM",      uint16_t, 0x1021, 0x0000, false, false, 0x0000, 0x31C3, 0x0000);
+LIBCRC_MODEL(Crc16Kermit,     "CRC-16/KERMIT",      uint16_t, 0x1021, 0x0000, true,  true,  0x0000, 0x2189, 0x0000);
+LIBCRC_MODEL(Crc16IbmSdlc,    "CRC-16/IBM-SDLC",    uint16_t, 0x1021, 0xFFFF, true,  true,  0xFFFF, 0x906E, 0xF0B8);
+LIBCRC_MODEL(Crc16Genibus,    "CRC-16/GENIBUS",     uint16_t, 0x1021, 0xFFFF, false, false, 0xFFFF, 0xD64E, 0x1D0F);
+LIBCRC_MODEL_WIDTH(Crc24OpenPgp, "CRC-24/OPENPGP",  uint32_t, 24, 0x864CFB, 0xB704CE, false, false, 0x000000, 0x21CF02, 0x000000);
+LIBCRC_MODEL(Crc32IsoHdlc,    "CRC-32/ISO-HDLC",    uint32_t, 0x04C11DB7, 0xFFFFFFFF, true,  true,  0xFFFFFFFF, 0xCBF43926, 0xDEBB20E3);
+LIBCRC_MODEL(Crc32Iscsi,      "CRC-32/ISCSI",       uint32_t, 0x1EDC6F41, 0xFFFFFFFF, true,  true,  0xFFFFFFFF, 0xE3069283, 0xB798B438);
+LIBCRC_MODEL(Crc32Bzip2,      "CRC-32/BZIP2",       uint32_t, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 0xFC891918, 0xC704DD7B);
+LIBCRC_MODEL(Crc32Mpeg2,      "CRC-32/MPEG-2",      uint32_t, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000, 0x0376E6E7, 0x00000000);
+LIBCRC_MODEL(Crc32Cksum,      "CRC-32/CKSUM",       uint32_t, 0x04C11DB7, 0x00000000, false, false, 0xFFFFFFFF, 0x765E7680, 0xC704DD7B);
+LIBCRC_MODEL(Crc64Xz,         "CRC-64/XZ",          uint64_t, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true,  true,  0xFFFFFFFFFFFFFFFF, 0x995DC9BBDF1939FA, 0x49958C9ABD7D353F);
+LIBCRC_MODEL(Crc64Ecma182,    "CRC-64/ECMA-182",    uint64_t, 0x42F0E1EBA9EA3693, 0x0000000000000000, false, false, 0x0000000000000000, 0x6C40DF5F0B497347, 0x0000000000000000);
+LIBCRC_MODEL(Crc64GoIso,      "CRC-64/GO-ISO",      uint64_t, 0x000000000000001B, 0xFFFFFFFFFFFFFFFF, true,  true,  0xFFFFFFFFFFFFFFFF, 0xB90956C775A41001, 0x5300000000000000);
+LIBCRC_MODEL(Crc64We,         "CRC-64/WE",          uint64_t, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, false, false, 0xFFFFFFFFFFFFFFFF, 0x62EC59E3F1A4F00A, 0xFCACBEBD5931A992);
+#if defined(LIBCRC_INT128)
+LIBCRC_MODEL_WIDTH(Crc82Darc, "CRC-82/DARC",        uint128_t, 82, (uint128_t(0x0308C) << 64) | 0x0111011401440411, 0, true, true, 0,
+                   (uint128_t(0x09EA8) << 64) | 0x3F625023801FD612, 0);
+#endif
+
+#undef LIBCRC_MODEL
+#undef LIBCRC_MODEL_WIDTH
+
+using Crc32 = Crc32IsoHdlc;                             //!< The usual CRC-32 (Ethernet, zip, PNG...)
+using Crc32c = Crc32Iscsi;                              //!< CRC-32C (Castagnoli)
+using Crc16Ccitt = Crc16Ibm3740;                        //!< Known as CRC-16/CCITT-FALSE
+using Crc64 = Crc64Xz;                                  //!< The usual CRC-64 (xz, Go's ECMA table)
+
+/** ----------------------------------------------------
+ * @brief     Class Crc: streaming CRC computation of an algorithm of the catalogue, or any other CrcModel.
+ * @desc      The parameters of the algorithm are compile-time constants: the input reflection selects the shift
+ *            direction of a CrcFastCalcT, and the initial value, output reflection and final XOR are folded into
+ *            constants, so the computation costs the same as CrcFastCalcT::compute. Every function is constexpr.
+ *            A CRC narrower than its register type is computed as CrcWidthCalc does: with the polynomial shifted to
+ *            the top of the register, which is kept at the top for left shifting and in the low bits for right.
+ * ------ */
+template <typename Algo, unsigned N = 8>
+class Crc
+{
+public:
+    using Type = typename Algo::Type;                                                   //!< Register type
+
+    static constexpr unsigned shift = sizeof(Type) * 8 - Algo::width;                   //!< Unused bits of the register
+
+    using Engine = CrcFastCalcT<Type, Algo::refin? shiftRight : shiftLeft, Type(Algo::poly << shift), N>; //!< Calculator
+
+    static constexpr Type seed = Algo::refin? Type(libcrc::reverse(Algo::init) >> shift)                  //!< Initial register
+                                            : Type(Algo::init << shift);
+    static constexpr Type residue = Type(Algo::residue << (Algo::refin? 0 : shift));    //!< Register after a block and its CRC
+
+    /**
+     * @brief     Constructor. Starts a computation.
+     */
+    constexpr Crc() : register_(seed)
+    { };
+
+    /**
+     * @brief     Adds a data block to the computation.
+     */
+    constexpr Crc&                                      /** @return This object */
+    update(
+      const uint8_t* data,                              /** @param data    Pointer to the data block */
+      size_t length                                     /** @param length  Data length */
+    )
+    {
+        register_ = Engine::compute(data, length, register_);
+        return *this;
+    }
+
+    /**
+     * @brief     Provides the CRC of the data added so far. The computation can go on after it.
+     */
+    constexpr Type                                      /** @return Computed CRC */
+    finalize() const
+    {
+        return finish(register_);
+    }
+
+    /**
+     * @brief     Starts a new computation.
+     */
+    constexpr void
+    reset()
+    {
+        register_ = seed;
+    }
+
+    /**
+     * @brief     Computes the CRC of a data block in one call.
+     */
+    static constexpr Type                               /** @return Computed CRC */
+    compute(
+      const uint8_t* data,                              /** @param data    Pointer to the data block */
+      size_t length                                     /** @param length  Data length */
+    )
+    {
+        return finish(Engine::compute(data, length, seed));
+    }
+
+    /**
+     * @brief     Computes the CRC of a text in one call, such as an identifier, also at compile time.
+     */
+    static constexpr Type                               /** @return Computed CRC */
+    compute(
+      const char* text,                                 /** @param text    Pointer to the text */
+      size_t length                                     /** @param length  Text length */
+    )
+    {
+        if (!LIBCRC_IS_CONSTANT_EVALUATED())
+            return compute(reinterpret_cast<const uint8_t*>(text), length);
+        Type reg = seed;
+        for (size_t idx = 0; idx < length; ++idx)
+            reg = tableStep<Type, Algo::refin? shiftRight : shiftLeft>(Engine::getLookupTable(), reg, uint8_t(text[idx]));
+        return finish(reg);
+    }
+
+#if defined(__cpp_lib_string_view)
+    /**
+     * @brief     Computes the CRC of a text in one call, also at compile time: Crc<Crc32c>::compute("topic").
+     */
+    static constexpr Type                               /** @return Computed CRC */
+    compute(
+      std::string_view text                             /** @param text    Text */
+    )
+    {
+        return compute(text.data(), text.size());
+    }
+#endif
+
+    /**
+     * @brief     Checks a data block followed by its CRC, as the algorithm appends it, in a single pass.
+     * @desc      The register after a block and its correct CRC is always the residue, so the CRC is neither
+     *            extracted nor finished. length must include the CRC.
+     */
+    static constexpr bool                               /** @return true if the CRC is right */
+    verify(
+      const uint8_t* data,                              /** @param data    Pointer to the data block and its CRC */
+      size_t length                                     /** @param length  Data length, CRC included */
+    )
+    {
+        static_assert(Algo::width % 8 == 0, "The CRC must be made of whole bytes");
+        return Engine::compute(data, length, seed) == residue;
+    }
+
+    /**
+     * @brief     Applies the output reflection and the final XOR to a register.
+     */
+    static constexpr Type                               /** @return CRC */
+    finish(
+      Type reg                                          /** @param reg     Register */
+    )
+    {
+        return Type((Algo::refin? (Algo::refout? reg : Type(libcrc::reverse(reg) >> shift))
+                                : (Algo::refout? libcrc::reverse(reg) : Type(reg >> shift))) ^ Algo::xorout);
+    }
+
+private:
+    Type register_;                                     //!< Register of the computation in progress
+};
+
+#if __cplusplus < 201703L
+template <typename Algo, unsigned N>
+constexpr unsigned Crc<Algo, N>::shift;
+template <typename Algo, unsigned N>
+constexpr typename Crc<Algo, N>::Type Crc<Algo, N>::seed;
+template <typename Algo, unsigned N>
+constexpr typename Crc<Algo, N>::Type Crc<Algo, N>::residue;
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Literals: CRCs of string literals computed at compile time, usable as constants and case labels.
+ * @desc      using namespace libcrc::literals; switch (id) { case "topic"_crc32c: ... }. The tables are built at compile
+ *            time too, only one per algorithm.
+ * ------ */
+namespace literals {
+
+constexpr uint32_t operator""_crc32(const char* text, size_t length) { return Crc<Crc32, 1>::compute(text, length); }
+constexpr uint32_t operator""_crc32c(const char* text, size_t length) { return Crc<Crc32c, 1>::compute(text, length); }
+constexpr uint64_t operator""_crc64(const char* text, size_t length) { return Crc<Crc64, 1>::compute(text, length); }
+
+#if defined(LIBCRC_HAS_CONSTANT_EVALUATED)                // Compile-time computation is only possible with it
+static_assert("123456789"_crc32 == Crc32::check, "CRC-32 literal");
+static_assert("123456789"_crc32c == Crc32c::check, "CRC-32C literal");
+static_assert("123456789"_crc64 == Crc64::check, "CRC-64 literal");
+#endif
+
+} // namespace literals
+
+#if defined(LIBCRC_X86)
+/** ----------------------------------------------------
+ * @brief     Struct ClmulOps: 128-bit lane operations of the carry-less multiplication engine (x86-64, PCLMULQDQ).
+ * ------ */
+struct ClmulOps
+{
+    using Lane = __m128i;
+
+    /**
+     * @brief     Loads 16 bytes, arranged so that the first stream bit is the most significant one for left shifting.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    load(const uint8_t* data)
+    {
+        Lane lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        if (dir == shiftLeft)
+            lane = _mm_shuffle_epi8(lane, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+        return lane;
+    }
+
+    /**
+     * @brief     Adds the register to the lane that comes first in the stream.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    inject(Lane lane, uint64_t crc)
+    {
+        Lane value = (dir == shiftLeft)? _mm_set_epi64x(static_cast<long long>(crc), 0) : _mm_cvtsi64_si128(static_cast<long long>(crc));
+        return _mm_xor_si128(lane, value);
+    }
+
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    add(Lane a, Lane b)
+    {
+        return _mm_xor_si128(a, b);
+    };
+
+    /**
+     * @brief     Multiplies the low and high halves of the lane by a pair of folding constants and adds the products.
+     */
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    fold(Lane lane, const uint64_t* pair)
+    {
+        Lane mult = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pair));
+        return _mm_xor_si128(_mm_clmulepi64_si128(lane, mult, 0x00), _mm_clmulepi64_si128(lane, mult, 0x11));
+    };
+
+    /**
+     * @brief     Reduces the last lane to a 64-bit register: 128 bits * x^64 -> 128 bits -> Barrett -> 64 bits.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static uint64_t
+    reduce(Lane x, const ClmulConstants& k)
+    {
+        const Lane reduce = _mm_set_epi64x(static_cast<long long>(k.barrett_), static_cast<long long>(k.final_));
+        const Lane poly = _mm_cvtsi64_si128(static_cast<long long>(k.poly_));
+        if (dir == shiftLeft)
+        {
+            Lane y = _mm_xor_si128(_mm_clmulepi64_si128(x, reduce, 0x01), _mm_slli_si128(x, 8));
+            Lane q = _mm_xor_si128(_mm_srli_si128(_mm_clmulepi64_si128(y, reduce, 0x11), 8), _mm_srli_si128(y, 8));
+            Lane r = _mm_xor_si128(_mm_clmulepi64_si128(q, poly, 0x00), y);
+            return static_cast<uint64_t>(_mm_cvtsi128_si64(r));
+        }
+        Lane y = _mm_xor_si128(_mm_clmulepi64_si128(x, reduce, 0x00), _mm_srli_si128(x, 8));
+        Lane q = _mm_clmulepi64_si128(y, reduce, 0x10);
+        Lane p = _mm_clmulepi64_si128(q, poly, 0x00);
+        uint64_t product = (static_cast<uint64_t>(_mm_extract_epi64(p, 1)) << 1) | (static_cast<uint64_t>(_mm_cvtsi128_si64(p)) >> 63);
+        return static_cast<uint64_t>(_mm_extract_epi64(y, 1)) ^ product;
+    }
+    /**
+     * @brief     Multiplies a 64-bit register by x^64 modulo G with a Barrett reduction.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static uint64_t
+    reduceWord(uint64_t t, uint64_t barrett, uint64_t poly)
+    {
+        const Lane k = _mm_set_epi64x(static_cast<long long>(poly), static_cast<long long>(barrett));
+        const Lane x = _mm_cvtsi64_si128(static_cast<long long>(t));
+        if (dir == shiftLeft)
+        {
+            uint64_t q = t ^ static_cast<uint64_t>(_mm_extract_epi64(_mm_clmulepi64_si128(x, k, 0x00), 1));
+            return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(q)), k, 0x10)));
+        }
+        Lane p = _mm_clmulepi64_si128(_mm_clmulepi64_si128(x, k, 0x00), k, 0x10);
+        return (static_cast<uint64_t>(_mm_extract_epi64(p, 1)) << 1) | (static_cast<uint64_t>(_mm_cvtsi128_si64(p)) >> 63);
+    }
+};
+#elif defined(LIBCRC_ARM64)
+/** ----------------------------------------------------
+ * @brief     Struct ClmulOps: 128-bit lane operations of the carry-less multiplication engine (ARMv8, PMULL).
+ * ------ */
+struct ClmulOps
+{
+    using Lane = uint64x2_t;
+
+    /**
+     * @brief     Loads 16 bytes, arranged so that the first stream bit is the most significant one for left shifting.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    load(const uint8_t* data)
+    {
+        uint8x16_t bytes = vld1q_u8(data);
+        if (dir == shiftLeft)
+            bytes = vrev64q_u8(vextq_u8(bytes, bytes, 8));
+        return vreinterpretq_u64_u8(bytes);
+    }
+
+    /**
+     * @brief     Adds the register to the lane that comes first in the stream.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    inject(Lane lane, uint64_t crc)
+    {
+        Lane value = (dir == shiftLeft)? vcombine_u64(vcreate_u64(0), vcreate_u64(crc)) : vcombine_u64(vcreate_u64(crc), vcreate_u64(0));
+        return veorq_u64(lane, value);
+    }
+
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    add(Lane a, Lane b)
+    {
+        return veorq_u64(a, b);
+    };
+
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    multiply(uint64_t a, uint64_t b)
+    {
+        return vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+    };
+
+    /**
+     * @brief     Multiplies the low and high halves of the lane by a pair of folding constants and adds the products.
+     */
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static Lane
+    fold(Lane lane, const uint64_t* pair)
+    {
+        return veorq_u64(multiply(vgetq_lane_u64(lane, 0), pair[0]), multiply(vgetq_lane_u64(lane, 1), pair[1]));
+    };
+
+    /**
+     * @brief     Reduces the last lane to a 64-bit register: 128 bits * x^64 -> 128 bits -> Barrett -> 64 bits.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static uint64_t
+    reduce(Lane x, const ClmulConstants& k)
+    {
+        const Lane zero = vdupq_n_u64(0);
+        if (dir == shiftLeft)
+        {
+            Lane y = veorq_u64(multiply(vgetq_lane_u64(x, 1), k.final_), vextq_u64(zero, x, 1));
+            uint64_t high = vgetq_lane_u64(y, 1);
+            uint64_t q = high ^ vgetq_lane_u64(multiply(high, k.barrett_), 1);
+            return vgetq_lane_u64(y, 0) ^ vgetq_lane_u64(multiply(q, k.poly_), 0);
+        }
+        Lane y = veorq_u64(multiply(vgetq_lane_u64(x, 0), k.final_), vextq_u64(x, zero, 1));
+        uint64_t q = vgetq_lane_u64(multiply(vgetq_lane_u64(y, 0), k.barrett_), 0);
+        Lane p = multiply(q, k.poly_);
+        return vgetq_lane_u64(y, 1) ^ ((vgetq_lane_u64(p, 1) << 1) | (vgetq_lane_u64(p, 0) >> 63));
+    }
+    /**
+     * @brief     Multiplies a 64-bit register by x^64 modulo G with a Barrett reduction.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_CLMUL LIBCRC_ALWAYS_INLINE static uint64_t
+    reduceWord(uint64_t t, uint64_t barrett, uint64_t poly)
+    {
+        if (dir == shiftLeft)
+        {
+            uint64_t q = t ^ vgetq_lane_u64(multiply(t, barrett), 1);
+            return vgetq_lane_u64(multiply(q, poly), 0);
+        }
+        Lane p = multiply(vgetq_lane_u64(multiply(t, barrett), 0), poly);
+        return (vgetq_lane_u64(p, 1) << 1) | (vgetq_lane_u64(p, 0) >> 63);
+    }
+};
+#endif
+
+#if defined(LIBCRC_TARGET_CLMUL)
+/**
+ * @brief     Processes the data 8 bytes at a time, each one with a Barrett reduction of the register: no table and no
+ *            branch, with two dependent carry-less multiplications per word.
+ * @desc      The register is 64 bits wide: left aligned for left shifting, as is for right shifting.
+ */
+template <ShiftDir dir>
+LIBCRC_TARGET_CLMUL uint64_t                            /** @return Register after processing the words */
+clmulBarrett(
+    uint64_t barrett,                                   /** @param barrett  Barrett quotient, arranged for the shift direction */
+    uint64_t poly,                                      /** @param poly     Polynomial G without its x^64 term, arranged as well */
+    const uint8_t* data,                                /** @param data     Pointer to the data */
+    size_t words,                                       /** @param words    Number of 8-byte words to process */
+    uint64_t crc                                        /** @param crc      Register before processing the words */
+)
+{
+    for (size_t idx = 0; idx < words; ++idx, data += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        if (dir == shiftLeft)
+            word = __builtin_bswap64(word);             // First stream bit in the most significant one
+        crc = ClmulOps::reduceWord<dir>(crc ^ word, barrett, poly);
+    }
+    return crc;
+}
+
+/**
+ * @brief     Folds 16-byte blocks with carry-less multiplications and reduces them to a CRC.
+ * @desc      The register is 64 bits wide: left aligned for left shifting, as is for right shifting.
+ */
+template <ShiftDir dir>
+LIBCRC_TARGET_CLMUL uint64_t                            /** @return Register after processing the blocks */
+clmulFold(
+    const ClmulConstants& k,                            /** @param k       Folding constants */
+    const uint8_t* data,                                /** @param data    Pointer to the data; at least ClmulConstants::lanes blocks */
+    size_t blocks,                                      /** @param blocks  Number of 16-byte blocks to process */
+    uint64_t crc                                        /** @param crc     Register before processing the blocks */
+)
+{
+    using Ops = ClmulOps;
+    constexpr unsigned lanes = ClmulConstants::lanes;
+    typename Ops::Lane x[lanes];
+    LIBCRC_UNROLL
+    for (unsigned lane = 0; lane < lanes; ++lane)
+        x[lane] = Ops::load<dir>(data + lane * 16);
+    x[0] = Ops::inject<dir>(x[0], crc);
+    data += lanes * 16;
+    blocks -= lanes;
+
+    for (; blocks >= lanes; blocks -= lanes, data += lanes * 16)
+    {
+        LIBCRC_UNROLL
+        for (unsigned lane = 0; lane < lanes; ++lane)
+            x[lane] = Ops::add(Ops::fold(x[lane], k.fold_[lanes - 1]), Ops::load<dir>(data + lane * 16));
+    }
+
+    typename Ops::Lane result = x[lanes - 1];
+    LIBCRC_UNROLL
+    for (unsigned lane = 0; lane < lanes - 1; ++lane)
+        result = Ops::add(result, Ops::fold(x[lane], k.fold_[lanes - 2 - lane]));
+    for (; blocks > 0; --blocks, data += 16)
+        result = Ops::add(Ops::fold(result, k.fold_[0]), Ops::load<dir>(data));
+    return Ops::reduce<dir>(result, k);
+}
+#endif
+
+#if defined(LIBCRC_TARGET_VPCLMUL)
+/** ----------------------------------------------------
+ * @brief     Struct WideClmulOps: operations on four 128-bit lanes at a time (x86-64, AVX-512 VPCLMULQDQ).
+ * ------ */
+struct WideClmulOps
+{
+    using Lanes = __m512i;
+
+    /**
+     * @brief     Loads 64 bytes as four lanes, each one arranged as ClmulOps::load does.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static Lanes
+    load(const uint8_t* data)
+    {
+        Lanes lanes = _mm512_loadu_si512(data);
+        if (dir == shiftLeft)
+            lanes = _mm512_shuffle_epi8(lanes, broadcast(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+        return lanes;
+    }
+
+    /**
+     * @brief     Adds the register to the first lane.
+     */
+    template <ShiftDir dir>
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static Lanes
+    inject(Lanes lanes, uint64_t crc)
+    {
+        return _mm512_xor_si512(lanes, _mm512_inserti32x4(_mm512_setzero_si512(), ClmulOps::inject<dir>(_mm_setzero_si128(), crc), 0));
+    }
+
+    /**
+     * @brief     Repeats a lane four times. The masked intrinsics avoid spurious warnings of some GCC versions.
+     */
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static Lanes
+    broadcast(__m128i lane)
+    {
+        return _mm512_maskz_broadcast_i32x4(0xFFFF, lane);
+    }
+
+    /**
+     * @brief     Repeats a pair of folding constants in the four lanes.
+     */
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static Lanes
+    constants(const uint64_t* pair)
+    {
+        return broadcast(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pair)));
+    }
+
+    /**
+     * @brief     Extracts one of the four lanes.
+     */
+    template <int idx>
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static __m128i
+    lane(Lanes lanes)
+    {
+        return _mm512_maskz_extracti32x4_epi32(0xFF, lanes, idx);
+    }
+
+    /**
+     * @brief     Folds every lane with the constants and adds the next data: fold(lanes) + data.
+     */
+    LIBCRC_TARGET_VPCLMUL LIBCRC_ALWAYS_INLINE static Lanes
+    fold(Lanes lanes, Lanes mult, Lanes data)
+    {
+        return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(lanes, mult, 0x00), _mm512_clmulepi64_epi128(lanes, mult, 0x11), data, 0x96);
+    }
+};
+
+/**
+ * @brief     Folds 16-byte blocks with 512-bit carry-less multiplications and reduces them to a CRC.
+ * @desc      Sixteen lanes, 256 bytes, are folded in each iteration with four instructions. The lanes are then joined
+ *            into four and into one, and the blocks left are folded one at a time as in clmulFold.
+ */
+template <ShiftDir dir>
+LIBCRC_TARGET_VPCLMUL uint64_t                          /** @return Register after processing the blocks */
+clmulFoldWide(
+    const ClmulConstants& k,                            /** @param k       Folding constants */
+    const uint8_t* data,                                /** @param data    Pointer to the data; at least ClmulConstants::wide_lanes blocks */
+    size_t blocks,                                      /** @param blocks  Number of 16-byte blocks to process */
+    uint64_t crc                                        /** @param crc     Register before processing the blocks */
+)
+{
+    using Ops = ClmulOps;
+    using Wide = WideClmulOps;
+    typename Wide::Lanes x[4];
+    LIBCRC_UNROLL
+    for (unsigned idx = 0; idx < 4; ++idx)
+        x[idx] = Wide::load<dir>(data + idx * 64);
+    x[0] = Wide::inject<dir>(x[0], crc);
+    data += 256;
+    blocks -= 16;
+
+    const typename Wide::Lanes fold256 = Wide::constants(k.fold_[15]);
+    for (; blocks >= 16; blocks -= 16, data += 256)
+    {
+        LIBCRC_UNROLL
+        for (unsigned idx = 0; idx < 4; ++idx)
+            x[idx] = Wide::fold(x[idx], fold256, Wide::load<dir>(data + idx * 64));
+    }
+
+    const typename Wide::Lanes fold64 = Wide::constants(k.fold_[3]);
+    typename Wide::Lanes acc = Wide::fold(x[0], Wide::constants(k.fold_[11]), x[3]);
+    acc = Wide::fold(x[1], Wide::constants(k.fold_[7]), acc);
+    acc = Wide::fold(x[2], fold64, acc);
+    for (; blocks >= 4; blocks -= 4, data += 64)
+        acc = Wide::fold(acc, fold64, Wide::load<dir>(data));
+
+    typename Ops::Lane result = Wide::lane<3>(acc);
+    result = Ops::add(result, Ops::fold(Wide::lane<0>(acc), k.fold_[2]));
+    result = Ops::add(result, Ops::fold(Wide::lane<1>(acc), k.fold_[1]));
+    result = Ops::add(result, Ops::fold(Wide::lane<2>(acc), k.fold_[0]));
+    for (; blocks > 0; --blocks, data += 16)
+        result = Ops::add(Ops::fold(result, k.fold_[0]), Ops::load<dir>(data));
+    return Ops::reduce<dir>(result, k);
+}
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Class CrcClmulCalc: CRC calculator folding the data with carry-less multiplications.
+ * @desc      The data is processed in 128-bit lanes, eight in parallel, and the result is obtained with a Barrett
+ *            reduction. With AVX-512 VPCLMULQDQ, long blocks are processed sixteen lanes at a time with 512-bit
+ *            instructions. The constants are derived from the polynomial, so any CRC of up to 64 bits is supported.
+ *            Short blocks, the tail of every block and CPUs without carry-less multiplication use slicing-by-8.
+ *            Results are identical to CrcFastCalc for the same polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcClmulCalc : public CrcBase<T, dir>
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Carry-less multiplication is supported for registers up to 64 bits");
+
+public:
+    static constexpr size_t min_length = ClmulConstants::lanes * 16;    //!< Shorter blocks are computed with the lookup table
+    static constexpr size_t wide_length = 1024;                         //!< Shorter blocks are not folded with AVX-512
+
+    /**
+     * @brief     Constructor. Initializes the lookup table and the folding constants.
+     */
+    CrcClmulCalc(
+      T poly,                                           /** @param poly  Polynomial to use for the computation */
+      bool wide = true                                  /** @param wide  Use the 512-bit instructions, if available */
+    ) : CrcBase<T, dir>(poly),
+        table_calc_(poly),
+        constants_(ClmulConstants::make<dir>(uint64_t(poly) << (64 - reg_bits_))),
+        accelerated_(CpuFeatures::get().clmul),
+        wide_(wide && CpuFeatures::get().vpclmul)
+    { };
+
+    /**
+     * @brief     Constructor. Uses folding constants built elsewhere, such as the ones generated by test_libcrc++.
+     */
+    CrcClmulCalc(
+      T poly,                                           /** @param poly       Polynomial to use for the computation */
+      const ClmulConstants& constants,                  /** @param constants  Constants of the polynomial for the shift direction */
+      bool wide = true                                  /** @param wide       Use the 512-bit instructions, if available */
+    ) : CrcBase<T, dir>(poly),
+        table_calc_(poly),
+        constants_(constants),
+        accelerated_(CpuFeatures::get().clmul),
+        wide_(wide && CpuFeatures::get().vpclmul)
+    { };
+
+    /**
+     * @brief     Tells whether the carry-less multiplication is available; otherwise the lookup table is used.
+     */
+    bool                                                /** @return true if the CPU supports carry-less multiplication */
+    isAccelerated() const
+    {
+        return accelerated_;
+    };
+
+    /**
+     * @brief     Tells whether the 512-bit carry-less multiplication (AVX-512 VPCLMULQDQ) is used for long blocks.
+     */
+    bool                                                /** @return true if the CPU supports it and the library was built with it */
+    isWide() const
+    {
+#if defined(LIBCRC_TARGET_VPCLMUL)
+        return wide_;
+#else
+        return false;
+#endif
+    };
+
+    /**
+     * @brief     Provides a pointer to the lookup table.
+     */
+    const T*                                            /** @return Precalculated lookup table */
+    getLookupTable() const
+    {
+        return table_calc_.getLookupTable();
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+#if defined(LIBCRC_TARGET_CLMUL)
+        if (accelerated_ && length >= min_length)
+        {
+            size_t blocks = length / 16;
+            LIBCRC_STATS_SCOPE((isWide() && length >= wide_length)? engineClmulWide : engineClmul, blocks * 16);
+            uint64_t crc = (dir == shiftLeft)? uint64_t(seed) << (64 - reg_bits_) : uint64_t(seed);
+#if defined(LIBCRC_TARGET_VPCLMUL)
+            if (wide_ && length >= wide_length)
+                crc = clmulFoldWide<dir>(constants_, data, blocks, crc);
+            else
+#endif
+                crc = clmulFold<dir>(constants_, data, blocks, crc);
+            seed = (dir == shiftLeft)? T(crc >> (64 - reg_bits_)) : T(crc);
+            data += blocks * 16;
+            length -= blocks * 16;
+        }
+#endif
+        return table_calc_.compute(data, length, seed);
+    };
+
+private:
+    static constexpr unsigned reg_bits_ = sizeof(T) * 8;            //!< Register size in bits
+
+    CrcSlicingCalc<T, dir, 8> table_calc_;              //!< Table calculator for short blocks and tails
+    ClmulConstants constants_;                          //!< Folding and reduction constants
+    bool accelerated_;                                  //!< Carry-less multiplication available
+    bool wide_;                                         //!< 512-bit carry-less multiplication available
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcBarrettCalc: CRC calculator without any table and without branches.
+ * @desc      With carry-less multiplication, the data is processed 8 bytes at a time, reducing the register with a
+ *            Barrett reduction; the constants take 16 bytes. Without it, and for the last bytes of every block, the
+ *            bits are shifted through the register masking the polynomial instead of testing the bit shifted out.
+ *            Any CRC of up to 64 bits is supported. Nothing is allocated nor registered in TableRegistry unless
+ *            combine() or update() are called (see CrcBase::powers). Results are identical to CrcFastCalc for the same
+ *            polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcBarrettCalc : public CrcBase<T, dir>
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Barrett reduction is supported for registers up to 64 bits");
+
+public:
+    /**
+     * @brief     Constructor. Initializes the reduction constants.
+     */
+    CrcBarrettCalc(
+      T poly                                            /** @param poly  Polynomial to use for the computation */
+    ) : CrcBase<T, dir>(poly),
+        accelerated_(CpuFeatures::get().clmul)
+    {
+        uint64_t g = uint64_t(poly) << (64 - reg_bits_);
+        uint64_t mu = barrettQuotient(g);
+        barrett_ = (dir == shiftLeft)? mu : libcrc::reverse((uint64_t(1) << 63) | (mu >> 1));
+        poly_ = (dir == shiftLeft)? g : libcrc::reverse(g);
+    };
+
+    /**
+     * @brief     Tells whether the carry-less multiplication is available; otherwise the bits are shifted one by one.
+     */
+    bool                                                /** @return true if the CPU supports carry-less multiplication */
+    isAccelerated() const
+    {
+#if defined(LIBCRC_TARGET_CLMUL)
+        return accelerated_;
+#else
+        return false;
+#endif
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        LIBCRC_STATS_SCOPE(engineBarrett, length);
+#if defined(LIBCRC_TARGET_CLMUL)
+        if (accelerated_ && length >= 8)
+        {
+            size_t words = length / 8;
+            uint64_t crc = (dir == shiftLeft)? uint64_t(seed) << (64 - reg_bits_) : uint64_t(seed);
+            crc = clmulBarrett<dir>(barrett_, poly_, data, words, crc);
+            seed = (dir == shiftLeft)? T(crc >> (64 - reg_bits_)) : T(crc);
+            data += words * 8;
+            length -= words * 8;
+        }
+#endif
+        T result = seed;
+        while (length--)
+            result = divideByteMasked<T, dir>(result ^ T(T(*data++) << this->pack_), this->polynomial_);
+        return result;
+    };
+
+private:
+    static constexpr unsigned reg_bits_ = sizeof(T) * 8;            //!< Register size in bits
+
+    bool accelerated_;                                  //!< Carry-less multiplication available
+    uint64_t barrett_;                                  //!< Barrett quotient floor(x^128 / G), arranged for the shift direction
+    uint64_t poly_;                                     //!< Polynomial G = poly * x^(64 - bits), arranged for the shift direction
+};
+
+#if defined(LIBCRC_TARGET_CRC32)
+/** ----------------------------------------------------
+ * @brief     Struct Crc32Ops: CRC-32 instructions of the CPU.
+ * @desc      `shift` multiplies a register by x^(8 * n) with a carry-less multiplication by k = x^(8 * n - 33) mod P,
+ *            which the CRC instruction then reduces to 32 bits.
+ * ------ */
+template <bool castagnoli>
+struct Crc32Ops
+{
+#if defined(LIBCRC_X86)
+    static_assert(castagnoli, "x86 only has the CRC-32C instruction");
+
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    word(uint32_t crc, uint64_t data)
+    {
+        return static_cast<uint32_t>(_mm_crc32_u64(crc, data));
+    }
+
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    byte(uint32_t crc, uint8_t data)
+    {
+        return _mm_crc32_u8(crc, data);
+    }
+
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    shift(uint32_t crc, uint64_t k)
+    {
+        __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)), _mm_cvtsi64_si128(static_cast<long long>(k)), 0x00);
+        return word(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product)));
+    }
+#else
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    word(uint32_t crc, uint64_t data)
+    {
+        return castagnoli? __crc32cd(crc, data) : __crc32d(crc, data);
+    }
+
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    byte(uint32_t crc, uint8_t data)
+    {
+        return castagnoli? __crc32cb(crc, data) : __crc32b(crc, data);
+    }
+
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    shift(uint32_t crc, uint64_t k)
+    {
+        poly128_t product = vmull_p64(static_cast<poly64_t>(crc), static_cast<poly64_t>(k));
+        return word(0, vgetq_lane_u64(vreinterpretq_u64_p128(product), 0));
+    }
+#endif
+
+    /**
+     * @brief     Processes the data in chunks of three streams of `length` bytes, interleaved to hide the latency of
+     *            the CRC instruction, while there is enough data.
+     */
+    template <size_t length>
+    LIBCRC_TARGET_CRC32 LIBCRC_ALWAYS_INLINE static uint32_t
+    streams(const uint8_t*& data, size_t& remaining, uint32_t crc, uint64_t k)
+    {
+        for (; remaining >= 3 * length; remaining -= 3 * length, data += 3 * length)
+        {
+            uint32_t crc1 = 0;
+            uint32_t crc2 = 0;
+            for (size_t idx = 0; idx < length; idx += 8)
+            {
+                crc = word(crc, loadWord<uint64_t, shiftRight>(data + idx));
+                crc1 = word(crc1, loadWord<uint64_t, shiftRight>(data + length + idx));
+                crc2 = word(crc2, loadWord<uint64_t, shiftRight>(data + 2 * length + idx));
+            }
+            crc = shift(crc, k) ^ crc1;
+            crc = shift(crc, k) ^ crc2;
+        }
+        return crc;
+    }
+};
+
+/**
+ * @brief     Computes a CRC-32 (right shifting) with the CRC instructions of the CPU.
+ */
+template <bool castagnoli>
+LIBCRC_TARGET_CRC32 uint32_t                            /** @return Computed CRC */
+crc32Hardware(
+    const uint8_t* data,                                /** @param data    Pointer to the data block */
+    size_t length,                                      /** @param length  Data length */
+    uint32_t crc,                                       /** @param crc     Seed or computed CRC from the previous block */
+    const uint64_t* shifts                              /** @param shifts  Multipliers for the long and short streams */
+)
+{
+    using Ops = Crc32Ops<castagnoli>;
+    crc = Ops::template streams<4096>(data, length, crc, shifts[0]);
+    crc = Ops::template streams<256>(data, length, crc, shifts[1]);
+    for (; length >= 8; length -= 8, data += 8)
+        crc = Ops::word(crc, loadWord<uint64_t, shiftRight>(data));
+    while (length--)
+        crc = Ops::byte(crc, *data++);
+    return crc;
+}
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Class CrcHwCalc: CRC calculator using the CRC instructions of the CPU when available.
+ * @desc      CRC-32C (0x1EDC6F41) in x86-64 with SSE4.2 and ARMv8, and CRC-32 (0x04C11DB7) in ARMv8, both with right
+ *            shifting, are computed with the CPU instructions. Three streams are processed at the same time and then
+ *            merged with a carry-less multiplication, so the CPU also needs PCLMULQDQ / PMULL. Any other polynomial,
+ *            register or CPU uses CrcClmulCalc. Results are identical to CrcFastCalc for the same polynomial and seed.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcHwCalc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Selects the CPU instructions for the polynomial, if there are any.
+     */
+    CrcHwCalc(
+      T poly                                            /** @param poly Polynomial to use for the computation */
+    ) : CrcBase<T, dir>(poly),
+        clmul_calc_(poly),
+        kernel_(selectKernel(poly))
+    {
+        if (kernel_ != nullptr)
+        {
+            shifts_[0] = shiftMultiplier(4096);
+            shifts_[1] = shiftMultiplier(256);
+        }
+    };
+
+    /**
+     * @brief     Tells whether the CRC instructions of the CPU are used for this polynomial.
+     */
+    bool                                                /** @return true if the CRC instructions are used */
+    isAccelerated() const
+    {
+        return kernel_ != nullptr;
+    };
+
+    /**
+     * @brief     Provides a pointer to the lookup table.
+     */
+    const T*                                            /** @return Precalculated lookup table */
+    getLookupTable() const
+    {
+        return clmul_calc_.getLookupTable();
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        if (kernel_ != nullptr)
+        {
+            LIBCRC_STATS_SCOPE(engineHardware, length);
+            return T(kernel_(data, length, uint32_t(seed), shifts_));
+        }
+        return clmul_calc_.compute(data, length, seed);
+    };
+
+private:
+    using Kernel = uint32_t (*)(const uint8_t*, size_t, uint32_t, const uint64_t*);
+
+    static constexpr uint32_t crc32c_poly_ = 0x1EDC6F41;            //!< CRC-32C (Castagnoli) polynomial
+    static constexpr uint32_t crc32_poly_ = 0x04C11DB7;             //!< CRC-32 polynomial
+
+    /**
+     * @brief     Selects the kernel using the CPU instructions for the polynomial.
+     */
+    static Kernel                                       /** @return Kernel, or nullptr if the CPU has no instructions for it */
+    selectKernel(
+      T poly                                            /** @param poly Polynomial to use for the computation */
+    )
+    {
+#if defined(LIBCRC_TARGET_CRC32)
+        const CpuFeatures& cpu = CpuFeatures::get();
+        if (!std::is_same<T, uint32_t>::value || dir != shiftRight || !cpu.clmul)
+            return nullptr;
+        if (poly == crc32c_poly_ && cpu.crc32c)
+            return crc32Hardware<true>;
+#if defined(LIBCRC_ARM64)
+        if (poly == crc32_poly_ && cpu.crc32)
+            return crc32Hardware<false>;
+#endif
+#endif
+        (void) poly;
+        return nullptr;
+    };
+
+    /**
+     * @brief     Multiplier to move a register 8 * length bits forward: x^(8 * length - 33) mod P, reflected.
+     */
+    uint64_t                                            /** @return Multiplier for Crc32Ops::shift */
+    shiftMultiplier(
+      size_t length                                     /** @param length  Length, in bytes, to move the register */
+    ) const
+    {
+        uint64_t g = uint64_t(libcrc::reverse(uint32_t(this->polynomial_))) << 32;
+        return libcrc::reverse(uint32_t(xPowMod(unsigned(8 * length - 33 + 32), g) >> 32));
+    };
+
+    CrcClmulCalc<T, dir> clmul_calc_;                   //!< Calculator for the polynomials without CPU instructions
+    Kernel kernel_;                                     //!< Kernel using the CPU instructions; nullptr if not available
+    uint64_t shifts_[2] = { 0, 0 };                     //!< Multipliers to merge the streams of 4096 and 256 bytes
+};
+
+/** ----------------------------------------------------
+ * @brief     Struct HashSoftOps: CRC of a 64-bit word with the lookup tables of an algorithm, as Crc32Ops::word.
+ * ------ */
+template <typename Algo>
+struct HashSoftOps
+{
+    LIBCRC_ALWAYS_INLINE static uint32_t
+    word(uint32_t crc, uint64_t data)
+    {
+        uint8_t bytes[8];
+        for (unsigned idx = 0; idx < 8; ++idx)
+            bytes[idx] = uint8_t(data >> (8 * idx));
+        return Crc<Algo>::Engine::compute(bytes, 8, crc);
+    }
+};
+
+/** ----------------------------------------------------
+ * @brief     Struct HashKernel: hash of a key as CRCs of its 8-byte words.
+ * @desc      Keys up to 8 bytes are packed in one word. Longer keys are taken as 2, 4 or 8 words, half of them from
+ *            the start and half from the end of the key, overlapping when the length is not a multiple of 8; keys
+ *            over 64 bytes are processed in blocks of 8 words. The words go alternately into two lanes, to overlap
+ *            the latency of the CRC steps, which are merged at the end. The 64-bit hash has two more lanes for the
+ *            upper half, over the words with their upper half XORed into the lower one: the two halves of the hash
+ *            of a key of up to 8 bytes then tell the whole key. The length goes into the seed of every lane.
+ * ------ */
+template <typename Ops, unsigned bits>
+struct HashKernel
+{
+    /**
+     * @brief     Hash of a key of up to 8 bytes, packed in a word.
+     */
+    LIBCRC_ALWAYS_INLINE static uint64_t                /** @return Hash value */
+    word(
+      uint64_t data,                                    /** @param data    Key */
+      uint32_t seed                                     /** @param seed    Seed, including the length */
+    )
+    {
+        const uint64_t low = Ops::word(seed, data);
+        if (bits == 32)
+            return low;
+        return uint64_t(Ops::word(seed ^ lane_seeds_[2], fold(data))) << 32 | low;
+    }
+
+    /**
+     * @brief     Hash of a key.
+     */
+    LIBCRC_ALWAYS_INLINE static uint64_t                /** @return Hash value */
+    hash(
+      const uint8_t* data,                              /** @param data    Pointer to the key */
+      size_t length,                                    /** @param length  Key length */
+      uint32_t seed                                     /** @param seed    Seed */
+    )
+    {
+        seed ^= uint32_t(length);
+        if (length <= 8)
+        {
+            uint64_t packed = 0;                        // The key as a little endian integer, from overlapping loads
+            if (length >= 4)
+                packed = loadWord<uint32_t, shiftRight>(data) | uint64_t(loadWord<uint32_t, shiftRight>(data + length - 4)) << (8 * (length - 4));
+            else if (length > 0)
+                packed = data[0] | uint32_t(data[length / 2]) << (8 * (length / 2)) | uint32_t(data[length - 1]) << (8 * (length - 1));
+            return word(packed, seed);
+        }
+
+        uint32_t lanes[4] = { seed, seed ^ lane_seeds_[1], seed ^ lane_seeds_[2], seed ^ lane_seeds_[3] };
+        if (length <= 16)
+            block<2>(data, length, lanes);
+        else if (length <= 32)
+            block<4>(data, length, lanes);
+        else if (length <= 64)
+            block<8>(data, length, lanes);
+        else
+        {
+            const uint8_t* last = data + length - 64;
+            for (; data < last; data += 64)
+                block<8>(data, 64, lanes);
+            block<8>(last, 64, lanes);
+        }
+
+        const uint64_t low = Ops::word(lanes[0], lanes[1]);
+        if (bits == 32)
+            return low;
+        return uint64_t(Ops::word(lanes[2], lanes[3])) << 32 | low;
+    }
+
+private:
+    static constexpr uint32_t lane_seeds_[4] = { 0, 0x9E3779B9, 0x7F4A7C15, 0xF39CC060 };   //!< Seeds of the lanes, XORed with the seed
+
+    LIBCRC_ALWAYS_INLINE static uint64_t
+    fold(uint64_t data)
+    {
+        return data ^ (data >> 32);
+    }
+
+    /**
+     * @brief     Adds to the lanes `count` words of a key: count / 2 from its start and count / 2 up to its end.
+     */
+    template <size_t count>
+    LIBCRC_ALWAYS_INLINE static void
+    block(
+      const uint8_t* data,                              /** @param data    Pointer to the key */
+      size_t length,                                    /** @param length  Key length, at least 8 * count / 2 bytes */
+      uint32_t* lanes                                   /** @param lanes   CRCs of the lanes */
+    )
+    {
+        LIBCRC_UNROLL
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            const uint64_t data_word = loadWord<uint64_t, shiftRight>((idx < count / 2)? data + 8 * idx
+                                                                                       : data + length - 8 * (count - idx));
+            lanes[idx & 1] = Ops::word(lanes[idx & 1], data_word);
+            if (bits == 64)
+                lanes[2 + (idx & 1)] = Ops::word(lanes[2 + (idx & 1)], fold(data_word));
+        }
+    }
+};
+
+#if __cplusplus < 201703L
+template <typename Ops, unsigned bits>
+constexpr uint32_t HashKernel<Ops, bits>::lane_seeds_[4];
+#endif
+
+#if defined(LIBCRC_TARGET_CRC32)
+/** ----------------------------------------------------
+ * @brief     Struct HashHardwareOps: Crc32Ops::word for HashKernel, inlined into the functions compiled for the CRC
+ *            instructions only.
+ * ------ */
+template <bool castagnoli>
+struct HashHardwareOps
+{
+    LIBCRC_TARGET_CRC32 static inline uint32_t
+    word(uint32_t crc, uint64_t data)
+    {
+        return Crc32Ops<castagnoli>::word(crc, data);
+    }
+};
+
+/**
+ * @brief     Hash of a key with the CRC instructions of the CPU, for the builds that do not enable them.
+ */
+template <typename Ops, unsigned bits>
+LIBCRC_TARGET_CRC32 uint64_t                            /** @return Hash value */
+hashHardware(
+    const uint8_t* data,                                /** @param data    Pointer to the key */
+    size_t length,                                      /** @param length  Key length */
+    uint32_t seed                                       /** @param seed    Seed */
+)
+{
+    return HashKernel<Ops, bits>::hash(data, length, seed);
+}
+
+/**
+ * @brief     Hash of a key of up to 8 bytes with the CRC instructions of the CPU, for the builds that do not enable them.
+ */
+template <typename Ops, unsigned bits>
+LIBCRC_TARGET_CRC32 uint64_t                            /** @return Hash value */
+hashHardwareWord(
+    uint64_t data,                                      /** @param data    Key */
+    uint32_t seed                                       /** @param seed    Seed, including the length */
+)
+{
+    return HashKernel<Ops, bits>::word(data, seed);
+}
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Class Hash: hash function for hash containers, built on the CRC of a 32-bit algorithm.
+ * @desc      std::unordered_map<std::string, V, libcrc::Hash<>> hashes the keys with CRC-32C; Hash<Algo, 64> gives
+ *            64-bit values, mixing two CRC lanes. Keys of 1 to 64 bytes take fixed paths of one to eight 8-byte words
+ *            (see HashKernel), with the CRC instructions of the CPU when the algorithm has them (CRC-32C, and also
+ *            CRC-32 in ARMv8) and the lookup tables of the algorithm otherwise, which give the same values. They
+ *            are used inline when the build enables them (-msse4.2 -mpclmul, -march=armv8-a+crc+crypto), and
+ *            after checking the CPU otherwise.
+ *            The values are not the CRC of the key, and CRCs are linear: Hash suits keys that are not chosen by an
+ *            adversary. Strings, C strings, std::string_view (is_transparent, for heterogeneous lookup), integers
+ *            and enumerations are accepted; integers hash as their bytes in little endian.
+ * ------ */
+template <typename Algo = Crc32c, unsigned bits = 32>
+class Hash
+{
+    static_assert(std::is_same<typename Algo::Type, uint32_t>::value && Algo::width == 32, "Hash needs a 32-bit algorithm");
+    static_assert(bits == 32 || bits == 64, "Hash values have 32 or 64 bits");
+
+public:
+    using is_transparent = void;                        //!< Lookup with any of the accepted key types
+
+    /**
+     * @brief     Constructor, with the initial value of the algorithm as seed.
+     */
+    Hash() : Hash(Crc<Algo>::seed)
+    { };
+
+    /**
+     * @brief     Constructor. Different seeds give unrelated values, as for the two levels of a perfect hash.
+     */
+    explicit Hash(
+      uint32_t seed                                     /** @param seed    Seed of the lanes */
+    ) : seed_(seed),
+        hardware_(hardware())
+    { };
+
+    /**
+     * @brief     Tells whether the CRC instructions of the CPU are used.
+     */
+    bool                                                /** @return true if the CRC instructions are used */
+    isAccelerated() const
+    {
+        return hardware_;
+    };
+
+    /**
+     * @brief     Hash of a key.
+     */
+    uint64_t                                            /** @return Hash value, of `bits` bits */
+    hash(
+      const uint8_t* data,                              /** @param data    Pointer to the key */
+      size_t length                                     /** @param length  Key length */
+    ) const
+    {
+#if defined(LIBCRC_NATIVE_CRC32)
+        if (instructions_)
+            return HashKernel<HardwareOps, bits>::hash(data, length, seed_);
+#elif defined(LIBCRC_TARGET_CRC32)
+        if (hardware_)
+            return hashHardware<HardwareOps, bits>(data, length, seed_);
+#endif
+        return HashKernel<HashSoftOps<Algo>, bits>::hash(data, length, seed_);
+    };
+
+    size_t                                              /** @return Hash value */
+    operator()(
+      const std::string& key                            /** @param key     Key */
+    ) const
+    {
+        return size_t(hash(reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+    };
+
+    size_t                                              /** @return Hash value */
+    operator()(
+      const char* key                                   /** @param key     Null-terminated key */
+    ) const
+    {
+        return size_t(hash(reinterpret_cast<const uint8_t*>(key), strlen(key)));
+    };
+
+#if defined(__cpp_lib_string_view)
+    size_t                                              /** @return Hash value */
+    operator()(
+      std::string_view key                              /** @param key     Key */
+    ) const
+    {
+        return size_t(hash(reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+    };
+#endif
+
+    template <typename K, typename = std::enable_if_t<std::is_integral<K>::value || std::is_enum<K>::value>>
+    size_t                                              /** @return Hash value */
+    operator()(
+      K key                                             /** @param key     Key, of up to 8 bytes */
+    ) const
+    {
+        static_assert(sizeof(K) <= 8, "Integer keys of up to 8 bytes");
+        const uint64_t data = uint64_t(key) & (~uint64_t(0) >> (64 - 8 * sizeof(K)));
+        const uint32_t seed = seed_ ^ uint32_t(sizeof(K));
+#if defined(LIBCRC_NATIVE_CRC32)
+        if (instructions_)
+            return size_t(HashKernel<HardwareOps, bits>::word(data, seed));
+#elif defined(LIBCRC_TARGET_CRC32)
+        if (hardware_)
+            return size_t(hashHardwareWord<HardwareOps, bits>(data, seed));
+#endif
+        return size_t(HashKernel<HashSoftOps<Algo>, bits>::word(data, seed));
+    }
+
+private:
+#if defined(LIBCRC_X86)
+    static constexpr bool instructions_ = Algo::refin && Algo::poly == 0x1EDC6F41;   //!< The CPU may have instructions for it
+#else
+    static constexpr bool instructions_ = Algo::refin && (Algo::poly == 0x1EDC6F41 || Algo::poly == 0x04C11DB7);
+#endif
+#if defined(LIBCRC_TARGET_CRC32)
+    using HardwareOps = std::conditional_t<instructions_, HashHardwareOps<Algo::poly == 0x1EDC6F41>, HashSoftOps<Algo>>;
+#endif
+
+    /**
+     * @brief     Tells whether the CRC instructions are used, checking the CPU when the build does not enable them.
+     */
+    static bool                                         /** @return true if the CRC instructions are used */
+    hardware()
+    {
+#if defined(LIBCRC_NATIVE_CRC32)
+        return instructions_;
+#elif defined(LIBCRC_TARGET_CRC32)
+        const CpuFeatures& cpu = CpuFeatures::get();
+        return instructions_ && ((Algo::poly == 0x1EDC6F41)? cpu.crc32c : cpu.crc32);
+#else
+        return false;
+#endif
+    };
+
+    uint32_t seed_;                                     //!< Seed of the lanes
+    bool hardware_;                                     //!< The CRC instructions are used
+};
+
+/** ----------------------------------------------------
+ * @brief     Class CrcAutoCalc: CRC calculator using the fastest engine for the CPU and the polynomial.
+ * @desc      The engine is chosen once, in the constructor, and computations go straight to it through a function
+ *            pointer. By order of preference: CrcClmulCalc with AVX-512, CrcHwCalc, CrcClmulCalc and slicing-by-8;
+ *            registers wider than 64 bits only have the table engines. When both CrcClmulCalc with AVX-512 and CrcHwCalc
+ *            are supported, the blocks shorter than CrcClmulCalc::min_length go to CrcHwCalc, which is about four
+ *            times faster on them.
+ *            A specific engine can be requested in the constructor or, for every calculator built with engineAuto,
+ *            with the environment variable LIBCRC_ENGINE (see engineName); the next one in the order of preference
+ *            is used if the CPU or the polynomial do not support it. getEngine() tells which one is in use. Results
+ *            are identical to CrcFastCalc for the same polynomial and seed, whatever the engine.
+ * ------ */
+template <typename T, ShiftDir dir, typename = std::enable_if_t<IsRegister<T>::value>>
+class CrcAutoCalc : public CrcBase<T, dir>
+{
+public:
+    /**
+     * @brief     Constructor. Selects the engine.
+     */
+    CrcAutoCalc(
+      T poly,                                           /** @param poly    Polynomial to use for the computation */
+      CrcEngine engine = engineAuto                     /** @param engine  Engine to use; engineAuto for the fastest one */
+    ) : CrcBase<T, dir>(poly),
+        lookup_table_(TableRegistry::get<T, dir>(poly))
+    {
+        if (engine == engineAuto)
+            engine = engineFromName(getenv("LIBCRC_ENGINE"));
+        select(poly, engine);
+    };
+
+    /**
+     * @brief     Provides the engine in use.
+     */
+    CrcEngine                                           /** @return Engine */
+    getEngine() const
+    {
+        return engine_;
+    };
+
+    /**
+     * @brief     Provides the name of the engine in use.
+     */
+    const char*                                         /** @return Name of the engine */
+    engineName() const
+    {
+        return libcrc::engineName(engine_);
+    };
+
+    /**
+     * @brief     Provides a pointer to the lookup table.
+     */
+    const T*                                            /** @return Precalculated lookup table */
+    getLookupTable() const
+    {
+        return lookup_table_;
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    T                                                   /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      T seed = 0                                        /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        return kernel_(calc_.get(), data, length, seed);
+    };
+
+private:
+    using Kernel = T (*)(const void*, const uint8_t*, size_t, T);
+
+    /**
+     * @brief     Calls the compute function of an engine.
+     */
+    template <typename Calc>
+    static T
+    run(const void* calc, const uint8_t* data, size_t length, T seed)
+    {
+        return static_cast<const Calc*>(calc)->compute(data, length, seed);
+    }
+
+    /**
+     * @brief     CRC instructions for the blocks shorter than CrcClmulCalc::min_length, carry-less folding for the others.
+     */
+    struct SplitCalc
+    {
+        CrcHwCalc<T, dir> hw;                           //!< Calculator for short blocks
+        CrcClmulCalc<T, dir> clmul;                     //!< Calculator for the others
+
+        T
+        compute(const uint8_t* data, size_t length, T seed) const
+        {
+            return (length < CrcClmulCalc<T, dir>::min_length)? hw.compute(data, length, seed) : clmul.compute(data, length, seed);
+        };
+    };
+
+    /**
+     * @brief     Sets the engine in use.
+     */
+    template <typename Calc>
+    void
+    use(std::shared_ptr<const Calc> calc, CrcEngine engine)
+    {
+        calc_ = std::move(calc);
+        kernel_ = &run<Calc>;
+        engine_ = engine;
+    }
+
+    /**
+     * @brief     Builds the engine requested, or the next one supported in the order of preference.
+     */
+    void
+    select(
+      T poly,                                           /** @param poly    Polynomial to use for the computation */
+      CrcEngine engine                                  /** @param engine  Engine requested */
+    )
+    {
+        if (selectWord(poly, engine, std::integral_constant<bool, (sizeof(T) <= sizeof(uint64_t))>()))
+            return;
+        if (engine == engineBitwise)
+            return use(std::make_shared<const CrcCalc<T, dir>>(poly), engineBitwise);
+        if (engine == engineNibble)
+            return use(std::make_shared<const CrcNibbleCalc<T, dir>>(poly), engineNibble);
+        if (engine == engineTable)
+            return use(std::make_shared<const CrcFastCalc<T, dir>>(poly), engineTable);
+        use(std::make_shared<const CrcSlicingCalc<T, dir, 8>>(poly), engineSlicing);
+    };
+
+    /**
+     * @brief     Builds the engines working on 64-bit words, if requested and supported.
+     */
+    bool                                                /** @return true if one of them is in use */
+    selectWord(
+      T poly,                                           /** @param poly    Polynomial to use for the computation */
+      CrcEngine engine,                                 /** @param engine  Engine requested */
+      std::true_type                                    /** @param -       The register fits in 64 bits */
+    )
+    {
+        if (engine == engineHardware || engine == engineAuto)
+        {
+            auto hw = std::make_shared<const CrcHwCalc<T, dir>>(poly);
+            if (hw->isAccelerated())
+            {
+                if (engine == engineAuto && CpuFeatures::get().vpclmul)
+                {
+                    CrcClmulCalc<T, dir> clmul(poly);
+                    if (clmul.isWide())
+                    {
+                        use(std::make_shared<const SplitCalc>(SplitCalc { *hw, clmul }), engineClmulWide);
+                        return true;
+                    }
+                }
+                use(hw, engineHardware);
+                return true;
+            }
+        }
+        if (engine == engineAuto || engine == engineHardware || engine == engineClmul || engine == engineClmulWide)
+        {
+            auto clmul = std::make_shared<const CrcClmulCalc<T, dir>>(poly, engine != engineClmul);
+            if (clmul->isAccelerated())
+            {
+                use(clmul, clmul->isWide()? engineClmulWide : engineClmul);
+                return true;
+            }
+        }
+        if (engine == engineBarrett)
+        {
+            use(std::make_shared<const CrcBarrettCalc<T, dir>>(poly), engineBarrett);
+            return true;
+        }
+        return false;
+    };
+
+    /**
+     * @brief     Registers wider than 64 bits only have the table engines.
+     */
+    bool                                                /** @return false */
+    selectWord(T, CrcEngine, std::false_type)
+    {
+        return false;
+    };
+
+    const T* lookup_table_;                             //!< Precalculated lookup table, shared through the registry
+    std::shared_ptr<const void> calc_;                  //!< Engine in use
+    Kernel kernel_ = nullptr;                           //!< Compute function of the engine
+    CrcEngine engine_ = engineAuto;                     //!< Engine in use
+};
+
+/**
+ * @brief     Register type of a calculator.
+ */
+template <typename Calc>
+using CrcRegister = decltype(std::declval<const Calc&>().compute(nullptr, 0));
+
+/** ----------------------------------------------------
+ * @brief     Class CrcWidthCalc: CRC of any width up to the register size, computed by another calculator.
+ * @desc      A CRC of w bits is computed in a wider register with the polynomial multiplied by x^(bits - w): for left
+ *            shifting the register is kept shifted to the top, for right shifting it is kept in the low bits, which
+ *            reflection leaves in place. Every engine then works unchanged, at the speed of the register size, and
+ *            only the seeds and results are converted. CRC-15, CRC-24 or CRC-82 (in a uint128_t) run at table speed.
+ *            Polynomials, seeds and results are given as usual for a w-bit CRC.
+ * ------ */
+template <typename Calc>
+class CrcWidthCalc
+{
+public:
+    using Type = CrcRegister<Calc>;                     //!< Register type
+
+    static constexpr ShiftDir direction = Calc::direction;  //!< Shift direction of the register
+
+    /**
+     * @brief     Constructor. Builds the calculator for the shifted polynomial.
+     */
+    template <typename... Args>
+    CrcWidthCalc(
+      Type poly,                                        /** @param poly   Polynomial of the CRC, of 'width' bits */
+      unsigned width,                                   /** @param width  Width of the CRC, from 1 to the register size */
+      Args&&... args                                    /** @param args   Further arguments of the calculator constructor */
+    ) : shift_(reg_bits_ - width),
+        mask_((width < reg_bits_)? Type((Type(1) << width) - 1) : Type(~Type(0))),
+        calc_(Type((poly & mask_) << shift_), std::forward<Args>(args)...)
+    { }
+
+    /**
+     * @brief     Provides the width of the CRC.
+     */
+    unsigned                                            /** @return Width, in bits */
+    getWidth() const
+    {
+        return reg_bits_ - shift_;
+    };
+
+    /**
+     * @brief     Provides the calculator doing the computation, which works on the shifted register.
+     */
+    const Calc&                                         /** @return Calculator */
+    engine() const
+    {
+        return calc_;
+    };
+
+    /**
+     * @brief     Computes the CRC of a data block.
+     */
+    Type                                                /** @return Computed CRC */
+    compute (
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      Type seed = 0                                     /** @param seed    Seed or computed CRC from the previous block */
+    ) const
+    {
+        return fromRegister(calc_.compute(data, length, toRegister(seed)));
+    };
+
+    /**
+     * @brief     Computes the CRC of the concatenation of two data blocks from the CRCs of both blocks.
+     * @desc      See CrcBase::combine.
+     */
+    Type                                                /** @return CRC of A followed by B */
+    combine(
+        Type crcA,                                      /** @param crcA     CRC of the first block */
+        Type crcB,                                      /** @param crcB     CRC of the second block */
+        uint64_t lengthB,                               /** @param lengthB  Length of the second block */
+        Type seedB = 0                                  /** @param seedB    Seed used to compute crcB */
+    ) const
+    {
+        return fromRegister(calc_.combine(toRegister(crcA), toRegister(crcB), lengthB, toRegister(seedB)));
+    };
+
+    /**
+     * @brief     Updates the CRC of a data block after some bytes inside it have been replaced.
+     * @desc      See CrcBase::update.
+     */
+    Type                                                /** @return CRC of the modified block */
+    update(
+        Type crc,                                       /** @param crc       CRC of the original block */
+        uint64_t length,                                /** @param length    Length of the block */
+        uint64_t offset,                                /** @param offset    Position of the replaced bytes */
+        const uint8_t* oldData,                         /** @param oldData   Original bytes */
+        const uint8_t* newData,                         /** @param newData   Bytes replacing them */
+        size_t count                                    /** @param count     Number of replaced bytes */
+    ) const
+    {
+        return fromRegister(calc_.update(toRegister(crc), length, offset, oldData, newData, count));
+    };
+
+private:
+    static constexpr unsigned reg_bits_ = sizeof(Type) * 8;         //!< Register size in bits
+
+    Type toRegister(Type crc) const
+    {
+        return (direction == shiftLeft)? Type(crc << shift_) : Type(crc & mask_);
+    };
+
+    Type fromRegister(Type reg) const
+    {
+        return (direction == shiftLeft)? Type(reg >> shift_) : reg;
+    };
+
+    unsigned shift_;                                    //!< Bits of the register below (left shifting) or above the CRC
+    Type mask_;                                         //!< Bits of the CRC
+    Calc calc_;                                         //!< Calculator working on the shifted register
+};
+
+#if __cplusplus < 201703L
+template <typename Calc>
+constexpr ShiftDir CrcWidthCalc<Calc>::direction;
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Parallel computation: the data block is split in chunks, their CRCs are computed by several threads and
+ *            then joined with combine(). Works with any calculator; results are identical to its compute().
+ * ------ */
+/**
+ * @brief     Tuning of the parallel computation.
+ */
+struct ParallelOptions
+{
+    unsigned threads = 0;                               //!< Number of threads, the caller included; 0 for all the cores
+    size_t threshold = size_t(4) << 20;                 //!< Data blocks shorter than this are computed by the caller
+    size_t chunk = size_t(256) << 10;                   //!< Length of the chunks given to the threads
+};
+
+/**
+ * @brief     Shared state of a parallel computation.
+ * @desc      The threads take the chunks in order from a shared counter, so the faster ones take more chunks. The state
+ *            is held by shared pointers, so tasks run by an executor after the computation ended find no chunks left
+ *            and return without touching the data.
+ */
+template <typename Calc>
+class ParallelJob
+{
+public:
+    using T = CrcRegister<Calc>;
+
+    /**
+     * @brief     Constructor. Splits the data block in chunks.
+     */
+    ParallelJob(
+      const Calc& calc,                                 /** @param calc    Calculator */
+      const uint8_t* data,                              /** @param data    Pointer to the data block to compute CRC */
+      size_t length,                                    /** @param length  Data length */
+      size_t chunk                                      /** @param chunk   Length of the chunks */
+    ) : calc_(calc),
+        data_(data),
+        length_(length),
+        chunk_(chunk),
+        chunks_((length + chunk - 1) / chunk),
+        crcs_(chunks_)
+    { };
+
+    /**
+     * @brief     Computes chunks until there are no more left.
+     */
+    void
+    run()
+    {
+        size_t done = 0;
+        for (size_t idx = next_.fetch_add(1); idx < chunks_; idx = next_.fetch_add(1), ++done)
+        {
+            size_t offset = idx * chunk_;
+            crcs_[idx] = calc_.compute(data_ + offset, std::min(chunk_, length_ - offset), 0);
+        }
+        if (done != 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ += done;
+            if (finished_ == chunks_)
+                finished_cv_.notify_all();
+        }
+    };
+
+    /**
+     * @brief     Waits until every chunk has been computed and joins their CRCs.
+     */
+    T                                                   /** @return Computed CRC */
+    join(
+      T seed                                            /** @param seed    Seed or computed CRC from the previous block */
+    )
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            finished_cv_.wait(lock, [this] { return finished_ == chunks_; });
+        }
+        T crc = seed;
+        for (size_t idx = 0; idx < chunks_; ++idx)
+            crc = calc_.combine(crc, crcs_[idx], std::min(chunk_, length_ - idx * chunk_));
+        return crc;
+    };
+
+private:
+    const Calc& calc_;                                  //!< Calculator
+    const uint8_t* data_;                               //!< Data block
+    size_t length_;                                     //!< Data length
+    size_t chunk_;                                      //!< Length of the chunks
+    size_t chunks_;                                     //!< Number of chunks
+    std::vector<T> crcs_;                               //!< CRCs of the chunks, computed with seed 0
+    std::atomic<size_t> next_ { 0 };                    //!< Next chunk to compute
+    size_t finished_ = 0;                               //!< Number of chunks computed
+    std::mutex mutex_;                                  //!< Protects finished_
+    std::condition_variable finished_cv_;               //!< Signals when every chunk has been computed
+};
+
+/**
+ * @brief     Computes the CRC of a data block with a user supplied executor.
+ * @desc      executor is any callable taking a task, a callable without arguments, and running it, e.g. by posting it
+ *            to a thread pool. options.threads - 1 tasks are given to it, and the calling thread computes chunks too,
+ *            so the computation ends even if the executor does not run the tasks.
+ */
+template <typename Calc, typename Executor,
+          typename = std::enable_if_t<!std::is_same<std::decay_t<Executor>, ParallelOptions>::value>>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+computeParallel(
+  const Calc& calc,                                     /** @param calc      Calculator */
+  const uint8_t* data,                                  /** @param data      Pointer to the data block to compute CRC */
+  size_t length,                                        /** @param length    Data length */
+  CrcRegister<Calc> seed,                               /** @param seed      Seed or computed CRC from the previous block */
+  Executor&& executor,                                  /** @param executor  Runs the tasks */
+  const ParallelOptions& options = ParallelOptions()    /** @param options   Tuning */
+)
+{
+    unsigned threads = (options.threads != 0)? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    size_t chunk = std::max(options.chunk, size_t(1));
+    if (length < options.threshold || threads < 2 || length <= chunk)
+        return calc.compute(data, length, seed);
+
+    auto job = std::make_shared<ParallelJob<Calc>>(calc, data, length, chunk);
+    try
+    {
+        for (unsigned task = 1; task < threads; ++task)
+            executor([job] { job->run(); });
+    }
+    catch (...)
+    {
+        job->run();                                     // Tasks already given may be using the data
+        job->join(seed);
+        throw;
+    }
+    job->run();
+    return job->join(seed);
+}
+
+/**
+ * @brief     Computes the CRC of a data block with several threads.
+ * @desc      The threads are created for the computation and joined before returning. If they cannot be created,
+ *            the remaining work is done by the calling thread.
+ */
+template <typename Calc>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+computeParallel(
+  const Calc& calc,                                     /** @param calc      Calculator */
+  const uint8_t* data,                                  /** @param data      Pointer to the data block to compute CRC */
+  size_t length,                                        /** @param length    Data length */
+  CrcRegister<Calc> seed = 0,                           /** @param seed      Seed or computed CRC from the previous block */
+  const ParallelOptions& options = ParallelOptions()    /** @param options   Tuning */
+)
+{
+    std::vector<std::thread> workers;
+    auto spawn = [&workers](std::function<void()>&& task)
+    {
+        try
+        {
+            workers.emplace_back(std::move(task));
+        }
+        catch (...)                                     // No more threads: the caller does the work
+        {
+        }
+    };
+    CrcRegister<Calc> crc = computeParallel(calc, data, length, seed, spawn, options);
+    for (std::thread& worker : workers)
+        worker.join();
+    return crc;
+}
+
+#if defined(__cpp_impl_coroutine)
+/** ----------------------------------------------------
+ * @brief     Asynchronous streaming computation for C++20 coroutines.
+ * ------ */
+/**
+ * @brief     Tuning of CrcStream.
+ */
+struct StreamOptions
+{
+    size_t batch = size_t(64) << 10;                    //!< Short feeds are gathered in blocks of this length for the workers
+    size_t threshold = size_t(256) << 10;               //!< Feeds at least this long are computed in place by the workers
+    size_t chunk = size_t(256) << 10;                   //!< Length of the pieces of the long feeds, one task each
+    std::function<void(std::coroutine_handle<>)> resume;    //!< Resumes a coroutine waiting for the workers; if empty, the worker does
+};
+
+/**
+ * @brief     Class CrcStream: CRC of a stream of data blocks fed by a coroutine, computed by a pool of workers.
+ * @desc      co_await feed(data) returns at once for blocks shorter than options.threshold: they are copied into a
+ *            batch, which is given to the executor when it reaches options.batch bytes. Longer blocks are split in
+ *            chunks, given to the executor as they are, and the coroutine is suspended until they are computed, so
+ *            the caller can reuse its buffer after the co_await. co_await result() waits for every pending task and
+ *            gives the CRC of the data fed so far, joining the CRCs of the pieces in order with combine; the stream
+ *            can go on after it. The executor is any callable taking a task and running it, e.g. by posting it to a
+ *            thread pool; if it throws, the task is run by the caller. The waiting coroutine is resumed by the last
+ *            worker to finish, or through options.resume, which can post it back to the event loop.
+ *            A stream is fed by one coroutine at a time, and must outlive the awaitables it returns. Results are
+ *            identical to the compute function of the calculator.
+ */
+template <typename Calc>
+class CrcStream
+{
+public:
+    using T = CrcRegister<Calc>;
+
+    /**
+     * @brief     Constructor.
+     */
+    template <typename Executor>
+    CrcStream(
+      const Calc& calc,                                 /** @param calc      Calculator; a copy is kept */
+      Executor&& executor,                              /** @param executor  Runs the tasks */
+      T seed = 0,                                       /** @param seed      Seed or computed CRC from the previous block */
+      const StreamOptions& options = StreamOptions()    /** @param options   Tuning */
+    ) : state_(std::make_shared<State>(calc, seed, options.resume)),
+        executor_(std::forward<Executor>(executor)),
+        options_(options)
+    {
+        options_.batch = std::max(options_.batch, size_t(1));
+        options_.chunk = std::max(options_.chunk, size_t(1));
+    }
+
+    CrcStream(const CrcStream&) = delete;
+    CrcStream& operator=(const CrcStream&) = delete;
+
+    /**
+     * @brief     Awaitable of feed(): suspends while the workers read the data in place.
+     */
+    struct FeedAwaiter
+    {
+        CrcStream& stream;                              //!< Stream fed
+        const uint8_t* data;                            //!< Data block
+        size_t length;                                  //!< Data length
+
+        bool await_ready()
+        {
+            if (length >= stream.options_.threshold)
+                return false;
+            stream.gather(data, length);
+            return true;
+        };
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            stream.submitBatch();
+            for (size_t offset = 0; offset < length; offset += stream.options_.chunk)
+                stream.submit(data + offset, std::min(stream.options_.chunk, length - offset), nullptr);
+            return stream.state_->wait(handle, false);
+        };
+
+        void await_resume()
+        { };
+    };
+
+    /**
+     * @brief     Awaitable of result(): suspends until every pending task is computed.
+     */
+    struct ResultAwaiter
+    {
+        CrcStream& stream;                              //!< Stream
+
+        bool await_ready()
+        {
+            stream.computeBatch();
+            return false;
+        };
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return stream.state_->wait(handle, true);
+        };
+
+        T await_resume()
+        {
+            std::lock_guard<std::mutex> lock(stream.state_->mutex);
+            return stream.state_->crc;
+        };
+    };
+
+    /**
+     * @brief     Adds a data block to the stream.
+     */
+    FeedAwaiter                                         /** @return Awaitable; the data must stay valid until it returns */
+    feed(
+      const uint8_t* data,                              /** @param data    Pointer to the data block */
+      size_t length                                     /** @param length  Data length */
+    )
+    {
+        return FeedAwaiter { *this, data, length };
+    };
+
+#if defined(__cpp_lib_span)
+    FeedAwaiter                                         /** @return Awaitable; the data must stay valid until it returns */
+    feed(
+      std::span<const uint8_t> data                     /** @param data    Data block */
+    )
+    {
+        return FeedAwaiter { *this, data.data(), data.size() };
+    };
+#endif
+
+    /**
+     * @brief     Provides the CRC of the data fed so far, once it is computed.
+     */
+    ResultAwaiter                                       /** @return Awaitable giving the computed CRC */
+    result()
+    {
+        return ResultAwaiter { *this };
+    };
+
+private:
+    struct Piece
+    {
+        T crc;                                          //!< CRC of the piece, with seed 0
+        size_t length;                                  //!< Length of the piece
+        bool done;                                      //!< The CRC has been computed
+    };
+
+    /**
+     * @brief     State shared with the tasks, which may end after the stream is destroyed.
+     */
+    struct State
+    {
+        State(const Calc& calc_arg, T seed, const std::function<void(std::coroutine_handle<>)>& resume_arg)
+          : calc(calc_arg), crc(seed), resume(resume_arg)
+        { };
+
+        /**
+         * @brief     Stores the CRC of a piece and joins the pieces done in order. Resumes the waiting coroutine when
+         *            what it waits for is done.
+         */
+        void complete(size_t index, T piece_crc, bool borrowed_data)
+        {
+            std::coroutine_handle<> ready;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pieces[index - first].crc = piece_crc;
+                pieces[index - first].done = true;
+                for (; !pieces.empty() && pieces.front().done; pieces.pop_front(), ++first)
+                    crc = calc.combine(crc, pieces.front().crc, pieces.front().length);
+                pending -= 1;
+                borrowed -= borrowed_data? 1 : 0;
+                if (waiter && (wait_all? pending == 0 : borrowed == 0))
+                    std::swap(ready, waiter);
+            }
+            if (!ready)
+                return;
+            if (resume)
+                resume(ready);
+            else
+                ready.resume();
+        };
+
+        /**
+         * @brief     Registers a coroutine to resume when every task, or every task reading data in place, is done.
+         */
+        bool                                            /** @return false if it is already done: no need to suspend */
+        wait(std::coroutine_handle<> handle, bool all)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if ((all? pending : borrowed) == 0)
+                return false;
+            waiter = handle;
+            wait_all = all;
+            return true;
+        };
+
+        const Calc calc;                                //!< Calculator
+        std::mutex mutex;                               //!< Protects the members below
+        std::deque<Piece> pieces;                       //!< Pieces not yet joined, in stream order
+        size_t first = 0;                               //!< Index of the first of them in the stream
+        T crc;                                          //!< CRC of the data before them
+        size_t pending = 0;                             //!< Tasks not finished
+        size_t borrowed = 0;                            //!< Tasks not finished reading the data of the caller
+        std::coroutine_handle<> waiter;                 //!< Coroutine waiting for the tasks
+        bool wait_all = false;                          //!< The coroutine waits for every task
+        std::function<void(std::coroutine_handle<>)> resume;    //!< Resumes the coroutine; nullptr to do it in the worker
+    };
+
+    /**
+     * @brief     Copies a short block into the batch, handing the batch to the workers when it is full.
+     */
+    void
+    gather(const uint8_t* data, size_t length)
+    {
+        while (length > 0)
+        {
+            if (!batch_)
+            {
+                batch_ = std::make_shared<std::vector<uint8_t>>();
+                batch_->reserve(options_.batch);
+            }
+            const size_t piece = std::min(length, options_.batch - batch_->size());
+            batch_->insert(batch_->end(), data, data + piece);
+            data += piece;
+            length -= piece;
+            if (batch_->size() == options_.batch)
+                submitBatch();
+        }
+    };
+
+    /**
+     * @brief     Hands the batch to the workers, if it has data.
+     */
+    void
+    submitBatch()
+    {
+        std::shared_ptr<std::vector<uint8_t>> batch = std::move(batch_);
+        if (batch && !batch->empty())
+            submit(batch->data(), batch->size(), batch);
+    };
+
+    /**
+     * @brief     Computes what is in the batch in the calling thread, instead of waiting for a worker.
+     */
+    void
+    computeBatch()
+    {
+        if (!batch_ || batch_->empty())
+            return;
+        const size_t index = append(batch_->size(), false);
+        state_->complete(index, state_->calc.compute(batch_->data(), batch_->size(), 0), false);
+        batch_.reset();
+    };
+
+    /**
+     * @brief     Adds a piece at the end of the stream.
+     */
+    size_t                                              /** @return Index of the piece in the stream */
+    append(size_t length, bool borrowed)
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pieces.push_back(Piece { 0, length, false });
+        state_->pending += 1;
+        state_->borrowed += borrowed? 1 : 0;
+        return state_->first + state_->pieces.size() - 1;
+    };
+
+    /**
+     * @brief     Hands a piece to a worker.
+     */
+    void
+    submit(
+      const uint8_t* data,                              /** @param data    Data of the piece */
+      size_t length,                                    /** @param length  Length of the piece */
+      std::shared_ptr<std::vector<uint8_t>> owner       /** @param owner   Batch holding the data; nullptr for the caller's data */
+    )
+    {
+        const bool borrowed = (owner == nullptr);
+        const size_t index = append(length, borrowed);
+        std::function<void()> task = [state = state_, owner, data, length, index, borrowed]
+        {
+            state->complete(index, state->calc.compute(data, length, 0), borrowed);
+        };
+        try
+        {
+            executor_(task);
+        }
+        catch (...)                                     // The executor cannot take it: the caller does the work
+        {
+            task();
+        }
+    };
+
+    std::shared_ptr<State> state_;                      //!< State shared with the tasks
+    std::function<void(std::function<void()>)> executor_;   //!< Runs the tasks
+    StreamOptions options_;                             //!< Tuning
+    std::shared_ptr<std::vector<uint8_t>> batch_;       //!< Short blocks gathered for a worker
+};
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Copy and CRC in a single pass: the data is copied in pieces that fit in the L1 cache, and the CRC of each
+ *            piece is computed right after copying it, while it is still in the cache. Works with any calculator;
+ *            results are identical to its compute().
+ * ------ */
+/**
+ * @brief     Length of the pieces copied before computing their CRC.
+ */
+constexpr size_t copy_piece = 8192;
+
+/**
+ * @brief     Copies a data block with non-temporal stores, which bypass the caches. Stores are fenced at the end.
+ * @desc      Regular copy where the CPU has no non-temporal stores available to the library.
+ */
+inline void
+streamingCopy(
+    uint8_t* dst,                                       /** @param dst     Destination */
+    const uint8_t* src,                                 /** @param src     Source */
+    size_t length                                       /** @param length  Data length */
+)
+{
+#if defined(LIBCRC_X86)
+    size_t head = (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15;  // Non-temporal stores must be aligned
+    if (head > length)
+        head = length;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    length -= head;
+    for (; length >= 64; length -= 64, dst += 64, src += 64)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+    }
+    memcpy(dst, src, length);
+    _mm_sfence();
+#else
+    memcpy(dst, src, length);
+#endif
+}
+
+/**
+ * @brief     Copies a data block and computes its CRC, reading the source only once.
+ */
+template <typename Calc>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+copyAndCompute(
+  const Calc& calc,                                     /** @param calc    Calculator */
+  uint8_t* dst,                                         /** @param dst     Destination; must not overlap the source */
+  const uint8_t* src,                                   /** @param src     Data block to copy and compute CRC */
+  size_t length,                                        /** @param length  Data length */
+  CrcRegister<Calc> seed = 0                            /** @param seed    Seed or computed CRC from the previous block */
+)
+{
+    for (size_t piece; length > 0; length -= piece, dst += piece, src += piece)
+    {
+        piece = std::min(length, copy_piece);
+        memcpy(dst, src, piece);
+        seed = calc.compute(src, piece, seed);
+    }
+    return seed;
+}
+
+/**
+ * @brief     Copies a data block with non-temporal stores and computes its CRC, reading the source only once.
+ * @desc      The copy does not evict useful data from the caches, which suits large transfers whose destination is not
+ *            read soon.
+ */
+template <typename Calc>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+copyAndComputeStreaming(
+  const Calc& calc,                                     /** @param calc    Calculator */
+  uint8_t* dst,                                         /** @param dst     Destination; must not overlap the source */
+  const uint8_t* src,                                   /** @param src     Data block to copy and compute CRC */
+  size_t length,                                        /** @param length  Data length */
+  CrcRegister<Calc> seed = 0                            /** @param seed    Seed or computed CRC from the previous block */
+)
+{
+    for (size_t piece; length > 0; length -= piece, dst += piece, src += piece)
+    {
+        piece = std::min(length, copy_piece);
+        streamingCopy(dst, src, piece);
+        seed = calc.compute(src, piece, seed);
+    }
+    return seed;
+}
+
+/** ----------------------------------------------------
+ * @brief     Scatter-gather computation: CRC of a data block stored in several segments. Short segments are gathered
+ *            into a buffer, so that the calculator always gets blocks long enough for its wide engines, and long
+ *            segments are computed in place. Works with any calculator; results are identical to its compute() on
+ *            the segments joined together.
+ * ------ */
+constexpr size_t gather_buffer = 4096;                  //!< Size of the buffer gathering short segments
+constexpr size_t gather_direct = 1024;                  //!< Segments from this length on are computed in place
+
+#if defined(LIBCRC_IOVEC)
+inline const uint8_t* segmentData(const iovec& segment) { return static_cast<const uint8_t*>(segment.iov_base); }
+inline size_t segmentLength(const iovec& segment) { return segment.iov_len; }
+#endif
+#if defined(__cpp_lib_span)
+inline const uint8_t* segmentData(std::span<const uint8_t> segment) { return segment.data(); }
+inline size_t segmentLength(std::span<const uint8_t> segment) { return segment.size(); }
+#endif
+
+/**
+ * @brief     Computes the CRC of a sequence of segments.
+ * @desc      The segments are the elements from first to last; segmentData() and segmentLength() must be defined for
+ *            them, as they are for iovec and std::span<const uint8_t>.
+ */
+template <typename Calc, typename Iterator>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+computeSegments(
+  const Calc& calc,                                     /** @param calc    Calculator */
+  Iterator first,                                       /** @param first   First segment */
+  Iterator last,                                        /** @param last    End of the segments */
+  CrcRegister<Calc> seed = 0                            /** @param seed    Seed or computed CRC from the previous block */
+)
+{
+    alignas(64) uint8_t buffer[gather_buffer];
+    size_t gathered = 0;
+    for (; first != last; ++first)
+    {
+        const uint8_t* data = segmentData(*first);
+        size_t length = segmentLength(*first);
+        if (length >= gather_direct || gathered + length > gather_buffer)
+        {
+            seed = calc.compute(buffer, gathered, seed);
+            gathered = 0;
+        }
+        if (length >= gather_direct)
+            seed = calc.compute(data, length, seed);
+        else
+        {
+            memcpy(buffer + gathered, data, length);
+            gathered += length;
+        }
+    }
+    return calc.compute(buffer, gathered, seed);
+}
+
+#if defined(LIBCRC_IOVEC)
+/**
+ * @brief     Computes the CRC of a data block given as an array of iovec, as used by readv / writev.
+ */
+template <typename Calc>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+computeSegments(
+  const Calc& calc,                                     /** @param calc      Calculator */
+  const iovec* segments,                                /** @param segments  Segments of the data block */
+  size_t count,                                         /** @param count     Number of segments */
+  CrcRegister<Calc> seed = 0                            /** @param seed      Seed or computed CRC from the previous block */
+)
+{
+    return computeSegments(calc, segments, segments + count, seed);
+}
+#endif
+
+#if defined(__cpp_lib_span)
+/**
+ * @brief     Computes the CRC of a data block given as a span of segments.
+ */
+template <typename Calc>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+computeSegments(
+  const Calc& calc,                                     /** @param calc      Calculator */
+  std::span<const std::span<const uint8_t>> segments,   /** @param segments  Segments of the data block */
+  CrcRegister<Calc> seed = 0                            /** @param seed      Seed or computed CRC from the previous block */
+)
+{
+    return computeSegments(calc, segments.begin(), segments.end(), seed);
+}
+#endif
+
+#if defined(__cpp_lib_ranges)
+/** ----------------------------------------------------
+ * @brief     Computation over ranges of bytes: std::string_view, std::span<const std::byte>, std::vector<char>, lists,
+ *            views... Contiguous ranges go straight to the calculator, without copies; the others are read into a
+ *            buffer of gather_buffer bytes, so every call to the calculator gets a full block. Works with any
+ *            calculator; results are identical to its compute() on the same bytes.
+ * ------ */
+/**
+ * @brief     Ranges and iterators whose elements are bytes: char, unsigned char, std::byte, int8_t, char8_t...
+ *            bool is not a byte. Arrays of characters are not ranges of bytes either, as string literals would
+ *            include their terminator: they go through std::string_view, as in Crc::compute.
+ */
+template <typename T>
+concept ByteElement = sizeof(T) == 1 && std::is_trivially_copyable_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+template <typename T>
+concept CharElement = std::is_same_v<std::remove_cv_t<T>, char>
+#if defined(__cpp_char8_t)
+    || std::is_same_v<std::remove_cv_t<T>, char8_t>
+#endif
+    ;
+
+template <typename R>
+concept ByteRange = std::ranges::input_range<R> && ByteElement<std::ranges::range_value_t<R>>
+                    && !(std::is_array_v<std::remove_reference_t<R>> && CharElement<std::ranges::range_value_t<R>>);
+
+static_assert(!ByteRange<const char (&)[10]> && ByteRange<std::string_view>, "String literals go through std::string_view");
+static_assert(ByteRange<const uint8_t (&)[10]> && !ByteRange<const bool (&)[10]>, "Arrays of bytes, not of bool");
+
+/**
+ * @brief     Computes the CRC of the bytes from first to last, read into a buffer in blocks.
+ */
+template <typename Calc, std::input_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+    requires ByteElement<std::iter_value_t<Iterator>>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+compute(
+  const Calc& calc,                                     /** @param calc    Calculator */
+  Iterator first,                                       /** @param first   First byte */
+  Sentinel last,                                        /** @param last    End of the data */
+  CrcRegister<Calc> seed = 0                            /** @param seed    Seed or computed CRC from the previous block */
+)
+{
+    if constexpr (std::contiguous_iterator<Iterator> && std::sized_sentinel_for<Sentinel, Iterator>)
+        return calc.compute(reinterpret_cast<const uint8_t*>(std::to_address(first)), size_t(last - first), seed);
+    else
+    {
+        alignas(64) uint8_t buffer[gather_buffer];
+        while (first != last)
+        {
+            size_t length = 0;
+            for (; length < gather_buffer && first != last; ++first)
+                buffer[length++] = static_cast<uint8_t>(*first);
+            seed = calc.compute(buffer, length, seed);
+        }
+        return seed;
+    }
+}
+
+/**
+ * @brief     Computes the CRC of a range of bytes.
+ */
+template <typename Calc, ByteRange Range>
+CrcRegister<Calc>                                       /** @return Computed CRC */
+compute(
+  const Calc& calc,                                     /** @param calc    Calculator */
+  Range&& range,                                        /** @param range   Data */
+  CrcRegister<Calc> seed = 0                            /** @param seed    Seed or computed CRC from the previous block */
+)
+{
+    if constexpr (std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>)
+        return calc.compute(reinterpret_cast<const uint8_t*>(std::ranges::data(range)), size_t(std::ranges::size(range)), seed);
+    else
+        return compute(calc, std::ranges::begin(range), std::ranges::end(range), seed);
+}
+#endif
+
+/** ----------------------------------------------------
+ * @brief     Verification of a data block followed by its CRC with the fastest engine, see Crc::verify.
+ * @desc      Frames are usually short, so the CRC instructions are preferred when they support the polynomial, then
+ *            the order of CrcAutoCalc. The calculator is built on the first call.
+ * ------ */
+template <typename Algo>
+bool                                                    /** @return true if the CRC is right */
+verify(
+  const uint8_t* data,                                  /** @param data    Pointer to the data block and its CRC */
+  size_t length                                         /** @param length  Data length, CRC included */
+)
+{
+    static_assert(Algo::width % 8 == 0, "The CRC must be made of whole bytes");
+
+    using Type = typename Algo::Type;
+    static const CrcAutoCalc<Type, Algo::refin? shiftRight : shiftLeft> calc(Crc<Algo>::Engine::polynomial, engineHardware);
+    return calc.compute(data, length, Crc<Algo>::seed) == Crc<Algo>::residue;
+}
+
+/** ----------------------------------------------------
+ * @brief     Verification of fixed-size records, each one holding the CRC of its leading bytes.
+ * @desc      Record k starts at base + k * recordSize and its CRC, written as the algorithm appends it (little endian
+ *            if refout, big endian otherwise), is at crcOffset. The CRC of the bytes up to crcOffset followed by the
+ *            CRC is the residue of the algorithm, so every record is checked without computing the CRC separately.
+ *            The CRC of a short record is a short chain of dependent steps, so records are computed several at a
+ *            time, interleaved: with the CRC instructions when they support the polynomial, or else folding one
+ *            record per 128-bit lane with carry-less multiplications, or else in lockstep from the lookup tables.
+ *            Records long enough to keep an engine busy by themselves go one after another to the engine
+ *            CrcAutoCalc would choose.
+ * ------ */
+constexpr size_t verify_group = 64;                     //!< Records computed in each pass: one word of the bitmap
+constexpr size_t verify_ways = 8;                       //!< Records interleaved by the CRC instructions and the folding
+constexpr size_t verify_long = 1024;                    //!< Longer records leave the CRC instructions for the AVX-512 folding
+
+#if defined(LIBCRC_TARGET_CRC32)
+/**
+ * @brief     Computes the CRCs of several records of the same length with the CRC instructions, interleaved.
+ */
+template <typename T, bool castagnoli, size_t ways>
+LIBCRC_TARGET_CRC32 void
+crc32HardwareRecords(
+    const uint8_t* const* records,                      /** @param records  Pointers to `ways` records */
+    size_t length,                                      /** @param length   Length of every record */
+    T seed,                                             /** @param seed     Seed of every record */
+    T* crcs                                             /** @param crcs     Computed CRCs */
+)
+{
+    using Ops = Crc32Ops<castagnoli>;
+    uint32_t crc[ways];
+    LIBCRC_UNROLL
+    for (size_t idx = 0; idx < ways; ++idx)
+        crc[idx] = uint32_t(seed);
+    size_t offset = 0;
+    for (; offset + 8 <= length; offset += 8)
+    {
+        LIBCRC_UNROLL
+        for (size_t idx = 0; idx < ways; ++idx)
+            crc[idx] = Ops::word(crc[idx], loadWord<uint64_t, shiftRight>(records[idx] + offset));
+    }
+    for (; offset < length; ++offset)
+    {
+        LIBCRC_UNROLL
+        for (size_t idx = 0; idx < ways; ++idx)
+            crc[idx] = Ops::byte(crc[idx], records[idx][offset]);
+    }
+    LIBCRC_UNROLL
+    for (size_t idx = 0; idx < ways; ++idx)
+        crcs[idx] = T(crc[idx]);
+}
+#endif
+
+#if defined(LIBCRC_TARGET_CLMUL)
+/**
+ * @brief     Folds the 16-byte blocks of several records of the same length, one record per lane, and reduces them.
+ * @desc      The registers are 64 bits wide: left aligned for left shifting, as is for right shifting.
+ */
+template <ShiftDir dir, size_t ways>
+LIBCRC_TARGET_CLMUL void
+clmulFoldRecords(
+    const ClmulConstants& k,                            /** @param k        Folding constants */
+    const uint8_t* const* records,                      /** @param records  Pointers to `ways` records */
+    size_t blocks,                                      /** @param blocks   Number of 16-byte blocks of every record, at least one */
+    uint64_t seed,                                      /** @param seed     Register before processing every record */
+    uint64_t* crcs                                      /** @param crcs     Registers after processing the blocks */
+)
+{
+    using Ops = ClmulOps;
+    typename Ops::Lane x[ways];
+    LIBCRC_UNROLL
+    for (size_t idx = 0; idx < ways; ++idx)
+        x[idx] = Ops::inject<dir>(Ops::load<dir>(records[idx]), seed);
+    for (size_t block = 1; block < blocks; ++block)
+    {
+        LIBCRC_UNROLL
+        for (size_t idx = 0; idx < ways; ++idx)
+            x[idx] = Ops::add(Ops::fold(x[idx], k.fold_[0]), Ops::load<dir>(records[idx] + block * 16));
+    }
+    LIBCRC_UNROLL
+    for (size_t idx = 0; idx < ways; ++idx)
+        crcs[idx] = Ops::reduce<dir>(x[idx], k);
+}
+
+/**
+ * @brief     Computes the CRCs of several records of the same length, folding them in parallel lanes.
+ * @desc      The bytes after the last whole block are computed from the lookup tables.
+ */
+template <typename T, ShiftDir dir, size_t ways>
+LIBCRC_TARGET_CLMUL void
+clmulRecords(
+    const ClmulConstants& k,                            /** @param k        Folding constants */
+    const T (*tables)[256],                             /** @param tables   8 lookup tables */
+    const uint8_t* const* records,                      /** @param records  Pointers to `ways` records */
+    size_t length,                                      /** @param length   Length of every record, at least 16 */
+    T seed,                                             /** @param seed     Seed of every record */
+    T* crcs                                             /** @param crcs     Computed CRCs */
+)
+{
+    constexpr unsigned reg_bits = sizeof(T) * 8;
+    const size_t blocks = length / 16;
+    uint64_t folded[ways];
+    clmulFoldRecords<dir, ways>(k, records, blocks, (dir == shiftLeft)? uint64_t(seed) << (64 - reg_bits) : uint64_t(seed), folded);
+    for (size_t idx = 0; idx < ways; ++idx)
+    {
+        const T crc = (dir == shiftLeft)? T(folded[idx] >> (64 - reg_bits)) : T(folded[idx]);
+        crcs[idx] = sliceCompute<T, dir, 8>(tables, records[idx] + blocks * 16, length - blocks * 16, crc);
+    }
+}
+#endif
+
+/**
+ * @brief     Verifies a series of records and marks the failing ones in a bitmap.
+ * @desc      Bit k % 64 of resultBitmap[k / 64] is set if record k is wrong, and cleared otherwise; resultBitmap must
+ *            hold (count + 63) / 64 words. If the CRC does not fit in the record, every record is wrong.
+ */
+template <typename Algo>
+size_t                                                  /** @return Number of wrong records */
+verifyRecords(
+  const uint8_t* base,                                  /** @param base          First record */
+  size_t recordSize,                                    /** @param recordSize    Size of every record */
+  size_t count,                                         /** @param count         Number of records */
+  size_t crcOffset,                                     /** @param crcOffset     Position of the CRC in the record */
+  uint64_t* resultBitmap                                /** @param resultBitmap  Bitmap of wrong records */
+)
+{
+    static_assert(Algo::width % 8 == 0 && sizeof(typename Algo::Type) <= sizeof(uint64_t), "The CRC must be whole bytes, up to 64 bits");
+
+    using Type = typename Algo::Type;
+    constexpr ShiftDir dir = Algo::refin? shiftRight : shiftLeft;
+    constexpr Type residue = Crc<Algo>::residue;
+    constexpr Type seed = Crc<Algo>::seed;
+    const size_t length = crcOffset + Algo::width / 8;  // Bytes covered by the residue
+    const Type (*tables)[256] = reinterpret_cast<const Type (*)[256]>(Crc<Algo>::Engine::getLookupTable());
+    static const CrcAutoCalc<Type, dir> calc(Crc<Algo>::Engine::polynomial);
+    const CrcEngine engine = calc.getEngine();
+    const bool alone = (engine == engineClmulWide || engine == engineClmul || engine == engineHardware)
+                       && length >= CrcClmulCalc<Type, dir>::min_length;     // Long enough to fill the folding lanes
+#if defined(LIBCRC_TARGET_CRC32)
+#if defined(LIBCRC_X86)
+    constexpr bool castagnoli = true;                   // The only instruction of x86
+    constexpr bool instructions = Algo::refin && Algo::width == 32 && Algo::poly == 0x1EDC6F41;
+#else
+    constexpr bool castagnoli = Algo::poly == 0x1EDC6F41;
+    constexpr bool instructions = Algo::refin && Algo::width == 32 && (Algo::poly == 0x1EDC6F41 || Algo::poly == 0x04C11DB7);
+#endif
+    const CpuFeatures& cpu = CpuFeatures::get();
+    const bool interleaved = instructions && cpu.clmul && (castagnoli? cpu.crc32c : cpu.crc32)
+                             && !(engine == engineClmulWide && length >= verify_long);
+#endif
+#if defined(LIBCRC_TARGET_CLMUL)
+    static const ClmulConstants constants = ClmulConstants::make<dir>(uint64_t(Crc<Algo>::Engine::polynomial) << (64 - sizeof(Type) * 8));
+    const bool folded = CpuFeatures::get().clmul && length >= 16 && !alone;   // At least one block
+#endif
+
+    size_t wrong = 0;
+    for (size_t first = 0; first < count; first += verify_group)
+    {
+        size_t group = std::min(verify_group, count - first);
+        const uint8_t* records[verify_group];
+        Type crcs[verify_group];
+        for (size_t idx = 0; idx < group; ++idx)
+            records[idx] = base + (first + idx) * recordSize;
+        const size_t ways = group - group % verify_ways;    // Records interleaved; the rest go one by one
+
+        if (length > recordSize)
+            for (size_t idx = 0; idx < group; ++idx)
+                crcs[idx] = Type(~residue);
+#if defined(LIBCRC_TARGET_CRC32)
+        else if (interleaved)
+        {
+            for (size_t idx = 0; idx < ways; idx += verify_ways)
+                crc32HardwareRecords<Type, castagnoli, verify_ways>(records + idx, length, seed, crcs + idx);
+            for (size_t idx = ways; idx < group; ++idx)
+                crc32HardwareRecords<Type, castagnoli, 1>(records + idx, length, seed, crcs + idx);
+        }
+#endif
+#if defined(LIBCRC_TARGET_CLMUL)
+        else if (folded)
+        {
+            for (size_t idx = 0; idx < ways; idx += verify_ways)
+                clmulRecords<Type, dir, verify_ways>(constants, tables, records + idx, length, seed, crcs + idx);
+            for (size_t idx = ways; idx < group; ++idx)
+                clmulRecords<Type, dir, 1>(constants, tables, records + idx, length, seed, crcs + idx);
+        }
+#endif
+        else if (alone)
+            for (size_t idx = 0; idx < group; ++idx)
+                crcs[idx] = calc.compute(records[idx], length, seed);
+        else
+            sliceBatch<Type, dir, 8, 4>(tables, records, length, crcs, group, seed);
+
+        uint64_t bits = 0;
+        for (size_t idx = 0; idx < group; ++idx)
+            if (crcs[idx] != residue)
+            {
+                bits |= uint64_t(1) << idx;
+                ++wrong;
+            }
+        resultBitmap[first / verify_group] = bits;
+    }
+    return wrong;
+}
+
+/** ----------------------------------------------------
+ * @brief     Class PolySearch: minimum Hamming distance of CRC polynomials, for choosing one.
+ * @desc      The Hamming distance of a CRC at a message length is the smallest number of bit errors it may miss: the
+ *            lowest weight of a codeword, message and CRC, divisible by the polynomial. Bit i of the codeword is
+ *            x^i mod P, so a codeword of weight w is a set of w of these syndromes adding up to zero. They are found
+ *            meeting in the middle, from the sorted sums of every w / 2 syndromes, by increasing weight up to a limit.
+ *            The cost grows with the codeword length n as n^(w / 2) in memory and n^((w + 1) / 2) in time for weight
+ *            w, so distances of 6 or 7 are only reachable for short messages. The distance does not grow with the
+ *            length, so the lengths are done from the longest one, which bounds the others from below. The hash set
+ *            of each thread is limited to maxMemory bytes: the distances needing more are not computed.
+ *            Polynomials are written in normal form without the x^width term, as in the catalogues.
+ * ------ */
+class PolySearch
+{
+public:
+    static constexpr unsigned max_distance = 7;         //!< Highest distance that can be computed
+    static constexpr unsigned not_computed = 0;         //!< Distance needing more memory than allowed
+
+    /**
+     * @brief     Distances of a polynomial.
+     */
+    struct Result
+    {
+        uint64_t poly;                                  //!< Polynomial
+        std::vector<unsigned> distances;                //!< Distance at each message length; limit + 1 if higher, or not_computed
+    };
+
+    /**
+     * @brief     Constructor. Sets the parameters of the search.
+     */
+    PolySearch(
+      unsigned width,                                   /** @param width         Width of the CRC, from 1 to 64 bits */
+      std::vector<size_t> messageBits,                  /** @param messageBits   Message lengths, in bits, CRC excluded */
+      unsigned limit = 6,                               /** @param limit         Highest distance looked for, up to max_distance */
+      size_t maxMemory = size_t(256) << 20              /** @param maxMemory     Memory for the hash set of each thread, in bytes */
+    ) : width_(width),
+        lengths_(std::move(messageBits)),
+        limit_((limit < max_distance)? limit : max_distance),
+        max_slots_(maxMemory / sizeof(uint64_t))
+    {
+        for (size_t idx = 0; idx < lengths_.size(); ++idx)
+            order_.push_back(idx);
+        std::sort(order_.begin(), order_.end(), [this](size_t a, size_t b) { return lengths_[a] > lengths_[b]; });
+    };
+
+    /**
+     * @brief     Computes the distances of a polynomial at every message length.
+     */
+    std::vector<unsigned>                               /** @return Distance at each message length; limit + 1 if higher, or not_computed */
+    distances(
+      uint64_t poly                                     /** @param poly  Polynomial */
+    ) const
+    {
+        std::vector<uint64_t> syndromes;
+        std::vector<uint64_t> sums;
+        std::vector<unsigned> result(lengths_.size());
+        evaluate(poly, result.data(), syndromes, sums);
+        return result;
+    };
+
+    /**
+     * @brief     Computes the distances of the polynomials in a range, with several threads.
+     * @desc      Only the polynomials with the x^0 term, odd ones, are evaluated: the others are x times a polynomial of
+     *            a lower degree. The threads take blocks of polynomials from a shared counter. The lengths whose
+     *            distance is not computed do not discard a polynomial. If a thread throws, as std::bad_alloc, the others
+     *            stop and the exception is thrown again by the caller.
+     */
+    std::vector<Result>                                 /** @return Polynomials found, in increasing order */
+    run(
+      uint64_t first,                                   /** @param first        First polynomial of the range */
+      uint64_t last,                                    /** @param last         Last polynomial of the range, included */
+      unsigned minDistance = 0,                         /** @param minDistance  Only polynomials with at least this distance at every length are kept */
+      unsigned threads = 0                              /** @param threads      Number of threads, the caller included; 0 for all the cores */
+    ) const
+    {
+        std::vector<Result> found;
+        first |= 1;
+        if (first > last)
+            return found;
+        const uint64_t count = ((last - first) >> 1) + 1;
+        threads = (threads != 0)? threads : std::max(1u, std::thread::hardware_concurrency());
+        std::atomic<uint64_t> next(0);
+        std::mutex mutex;
+        std::exception_ptr error;
+
+        auto search = [&]()
+        {
+            try
+            {
+                std::vector<uint64_t> syndromes;
+                std::vector<uint64_t> sums;
+                std::vector<Result> local;
+                std::vector<unsigned> result(lengths_.size());
+                for (uint64_t block = next.fetch_add(search_block); block < count; block = next.fetch_add(search_block))
+                    for (uint64_t idx = block; idx < std::min(count, block + search_block); ++idx)
+                    {
+                        uint64_t poly = first + 2 * idx;
+                        evaluate(poly, result.data(), syndromes, sums);
+                        if (std::all_of(result.begin(), result.end(), [minDistance](unsigned d) { return d >= minDistance || d == not_computed; }))
+                            local.push_back({ poly, result });
+                    }
+                std::lock_guard<std::mutex> lock(mutex);
+                found.insert(found.end(), local.begin(), local.end());
+            }
+            catch (...)                                 // Stops the search, for the caller to throw it
+            {
+                next.store(count);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned idx = 1; idx < threads && uint64_t(idx) * search_block < count; ++idx)
+        {
+            try
+            {
+                workers.emplace_back(search);
+            }
+            catch (...)                                 // No more threads: the caller does the work
+            {
+                break;
+            }
+        }
+        search();
+        for (std::thread& worker : workers)
+            worker.join();
+        if (error)
+            std::rethrow_exception(error);
+        std::sort(found.begin(), found.end(), [](const Result& a, const Result& b) { return a.poly < b.poly; });
+        return found;
+    };
+
+private:
+    static constexpr uint64_t search_block = 64;        //!< Polynomials taken by a thread at a time
+
+    /**
+     * @brief     Computes the distances of a polynomial, from the longest message length to the shortest.
+     */
+    void
+    evaluate(uint64_t poly, unsigned* result, std::vector<uint64_t>& syndromes, std::vector<uint64_t>& sums) const
+    {
+        if (order_.empty())
+            return;
+        const uint64_t mask = (width_ < 64)? (uint64_t(1) << width_) - 1 : ~uint64_t(0);
+        poly &= mask;
+        syndromes.resize(lengths_[order_[0]] + width_);
+        uint64_t syndrome = 1;                          // x^0
+        for (uint64_t& value : syndromes)
+        {
+            value = syndrome;
+            uint64_t top = (syndrome >> (width_ - 1)) & 1;
+            syndrome = ((syndrome << 1) & mask) ^ (top? poly : 0);
+        }
+
+        unsigned terms = 1;                             // x^width
+        for (uint64_t rest = poly; rest != 0; rest &= rest - 1)
+            ++terms;
+        unsigned distance = 1;                          // No codeword is lighter, at this length and the shorter ones
+        for (size_t idx : order_)
+            result[idx] = lowestWeight(syndromes.data(), lengths_[idx] + width_, distance, terms % 2 == 0, sums);
+    };
+
+    /**
+     * @brief     Finds the lowest weight of a codeword, knowing that there are none lighter than 'from'.
+     * @desc      The sums of every weight / 2 syndromes go to a hash set: two equal sums make a codeword of even weight,
+     *            and a sum of weight / 2 + 1 syndromes found in the set one of odd weight. No sum is zero, because there
+     *            is no lighter codeword, so zero marks the empty slots. If x + 1 divides the polynomial, which has then
+     *            an even number of terms, every codeword has even weight. 'from' is raised to the lowest weight not
+     *            ruled out, which is also a bound for the shorter lengths.
+     */
+    unsigned                                            /** @return Lowest weight, limit + 1 if higher, or not_computed */
+    lowestWeight(const uint64_t* syndromes, size_t length, unsigned& from, bool even, std::vector<uint64_t>& sums) const
+    {
+        unsigned half = 0;                              // Number of syndromes added in the set
+        for (; from <= limit_; ++from)
+        {
+            const unsigned weight = from;
+            if (weight == 1)
+            {
+                if (std::find(syndromes, syndromes + length, uint64_t(0)) != syndromes + length)
+                    return 1;
+                continue;
+            }
+            if (weight % 2 != 0 && even)
+                continue;
+            if (half != weight / 2)
+            {
+                size_t slots = 16;
+                for (double count = subsets(length, weight / 2) * 1.5; slots < count && slots <= max_slots_; slots <<= 1)
+                    ;
+                if (slots > max_slots_)
+                    return not_computed;
+                half = weight / 2;
+                sums.assign(slots, 0);
+                if (!addSums(syndromes, length, half, 0, 0, sums))
+                    return from = 2 * half;
+            }
+            if (weight % 2 != 0 && !findSums(syndromes, length, half + 1, 0, 0, sums))
+                return weight;
+        }
+        return limit_ + 1;
+    };
+
+    /**
+     * @brief     Number of sets of 'count' syndromes out of 'length'.
+     */
+    static double
+    subsets(size_t length, unsigned count)
+    {
+        double result = 1;
+        for (unsigned idx = 0; idx < count; ++idx)
+            result = result * double(length - idx) / double(idx + 1);
+        return result;
+    };
+
+    /**
+     * @brief     Slot of a sum in the hash set: the slot holding it, or the empty one where it goes.
+     */
+    static uint64_t&
+    slot(std::vector<uint64_t>& sums, uint64_t sum)
+    {
+        const size_t mask = sums.size() - 1;
+        size_t idx = size_t((sum * 0x9E3779B97F4A7C15) >> 32) & mask;
+        while (sums[idx] != 0 && sums[idx] != sum)
+            idx = (idx + 1) & mask;
+        return sums[idx];
+    };
+
+    /**
+     * @brief     Puts in the hash set the sums of every set of 'count' syndromes from 'first' on, each plus 'sum'.
+     */
+    static bool                                         /** @return false if a sum was already in the set */
+    addSums(const uint64_t* syndromes, size_t length, unsigned count, size_t first, uint64_t sum, std::vector<uint64_t>& sums)
+    {
+        if (count == 0)
+        {
+            uint64_t& entry = slot(sums, sum);
+            if (entry == sum)
+                return false;
+            entry = sum;
+            return true;
+        }
+        for (size_t bit = first; bit + count <= length; ++bit)
+            if (!addSums(syndromes, length, count - 1, bit + 1, sum ^ syndromes[bit], sums))
+                return false;
+        return true;
+    };
+
+    /**
+     * @brief     Looks for the sums of every set of 'count' syndromes from 'first' on, each plus 'sum', in the hash set.
+     */
+    static bool                                         /** @return false if a sum is in the set */
+    findSums(const uint64_t* syndromes, size_t length, unsigned count, size_t first, uint64_t sum, std::vector<uint64_t>& sums)
+    {
+        if (count == 0)
+            return slot(sums, sum) != sum;
+        for (size_t bit = first; bit + count <= length; ++bit)
+            if (!findSums(syndromes, length, count - 1, bit + 1, sum ^ syndromes[bit], sums))
+                return false;
+        return true;
+    };
+
+    unsigned width_;                                    //!< Width of the CRC
+    std::vector<size_t> lengths_;                       //!< Message lengths, in bits
+    std::vector<size_t> order_;                         //!< Indexes of the lengths, from the longest to the shortest
+    unsigned limit_;                                    //!< Highest distance looked for
+    size_t max_slots_;                                  //!< Highest number of slots of the hash set
 };
 
 } // namespace
@@ -0,0 +1,580 @@
+/**
+ * @package   libcrc++: C++ library for universal CRC calculation.
+ * @brief     Library benchmark: throughput of the calculators for every register size, direction and data length, with
+ *            the cache miss rates where the CPU counters can be read.
+ * @author    José Luis Sánchez Arroyo
+ * @section   License
+ * Copyright (c) 2017 - 2025 José Luis Sánchez Arroyo
+ * This software is distributed under the terms of the MIT license and comes WITHOUT ANY WARRANTY.
+ * Please read the file LICENSE for further details.
+ */
+
+#include "libcrc++.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>         // getopt
+#if defined(__x86_64__)
+#include <x86intrin.h>      // __rdtsc
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>   // perf_event_attr
+#include <sys/ioctl.h>      // ioctl
+#include <sys/syscall.h>    // SYS_perf_event_open
+#endif
+
+enum OutputFormat
+{
+    csv_format,
+    json_format
+};
+
+/** -----------------------------------------------------
+ * @brief     Benchmark settings
+ * ------ */
+struct Settings
+{
+    OutputFormat format = csv_format;
+    size_t min_length = 16;                             // Shortest data block
+    size_t max_length = size_t(1) << 30;                // Longest data block
+    double min_time = 0.1;                              // Minimum measuring time of each warm case, in seconds
+    unsigned cold_runs = 5;                             // Measures of each cold case
+    size_t evict_length = size_t(64) << 20;             // Data written to flush the caches before a cold measure
+    const char* engines = nullptr;                      // Comma separated list of engines to run; all if null
+    int bits = 0;                                       // Register size to run; all if 0
+    int dir = -1;                                       // Shift direction to run; both if -1
+    const char* layout = "aligned";                     // Placement of the lookup tables, as named in the report
+    libcrc::TableRegistry::Placement placement;         // Placement of the lookup tables
+};
+
+/** -----------------------------------------------------
+ * @brief     Result of a measure
+ * ------ */
+struct Measure
+{
+    double seconds = 0;
+    uint64_t cycles = 0;
+    uint64_t bytes = 0;
+    unsigned runs = 0;
+    uint64_t l1_reads = 0;                              // Cache counters; all 0 if they cannot be read
+    uint64_t l1_misses = 0;
+    uint64_t llc_reads = 0;
+    uint64_t llc_misses = 0;
+};
+
+static volatile uint64_t sink;                          // Keeps the results alive
+
+/**
+ * @brief     Time stamp counter, to report cycles per byte. 0 where there is none.
+ */
+static inline uint64_t Cycles()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/** -----------------------------------------------------
+ * @brief     Hardware counters of L1 data cache and last level cache reads and misses of the calling thread.
+ *            Only in Linux, and only if the kernel lets the process read them (see perf_event_paranoid).
+ * ------ */
+class CacheCounters
+{
+public:
+    CacheCounters()
+    {
+#if defined(__linux__)
+        const uint64_t read_access = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16);
+        const uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const uint64_t events[count] = { PERF_COUNT_HW_CACHE_L1D | read_access, PERF_COUNT_HW_CACHE_L1D | read_miss,
+                                         PERF_COUNT_HW_CACHE_LL | read_access, PERF_COUNT_HW_CACHE_LL | read_miss };
+        for (unsigned idx = 0; idx < count; ++idx)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = events[idx];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds_[idx] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~CacheCounters()
+    {
+        for (int fd : fds_)
+            if (fd >= 0)
+                close(fd);
+    }
+
+    /**
+     * @brief     Tells whether every counter can be read.
+     */
+    bool Available() const
+    {
+        return std::all_of(fds_, fds_ + count, [](int fd) { return fd >= 0; });
+    }
+
+    void Start()
+    {
+#if defined(__linux__)
+        if (Available())
+            for (int fd : fds_)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+    }
+
+    /**
+     * @brief     Stops the counters and adds them to a measure.
+     */
+    void Stop(Measure& measure)
+    {
+        uint64_t values[count] = { 0, 0, 0, 0 };
+#if defined(__linux__)
+        if (Available())
+            for (unsigned idx = 0; idx < count; ++idx)
+            {
+                ioctl(fds_[idx], PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fds_[idx], &values[idx], sizeof(values[idx])) != sizeof(values[idx]))
+                    values[idx] = 0;
+            }
+#endif
+        measure.l1_reads += values[0];
+        measure.l1_misses += values[1];
+        measure.llc_reads += values[2];
+        measure.llc_misses += values[3];
+    }
+
+private:
+    static const unsigned count = 4;
+    int fds_[count] = { -1, -1, -1, -1 };
+};
+
+static CacheCounters counters;
+
+/** -----------------------------------------------------
+ * @brief     Measures a calculator with the data cached: the block is computed until min_time has passed.
+ * ------ */
+template <typename Calc>
+Measure MeasureWarm(const Calc& calc, const uint8_t* data, size_t length, const Settings& settings)
+{
+    using Clock = std::chrono::steady_clock;
+    sink = sink + calc.compute(data, length, 0);        // Brings the data and the tables into the caches
+
+    Measure measure;
+    unsigned batch = 1;
+    counters.Start();
+    while (measure.seconds < settings.min_time)
+    {
+        Clock::time_point start = Clock::now();
+        uint64_t cycles = Cycles();
+        uint64_t result = 0;
+        for (unsigned run = 0; run < batch; ++run)
+            result += calc.compute(data, length, uint64_t(run));
+        measure.cycles += Cycles() - cycles;
+        measure.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        measure.bytes += uint64_t(length) * batch;
+        measure.runs += batch;
+        sink = sink + result;
+        batch = std::min(batch * 2, 1u << 20);
+    }
+    counters.Stop(measure);
+    return measure;
+}
+
+/** -----------------------------------------------------
+ * @brief     Measures a calculator with the data out of the caches: the caches are flushed before every run.
+ * ------ */
+template <typename Calc>
+Measure MeasureCold(const Calc& calc, const uint8_t* data, size_t length, std::vector<uint8_t>& evict, const Settings& settings)
+{
+    using Clock = std::chrono::steady_clock;
+    Measure measure;
+    for (unsigned run = 0; run < settings.cold_runs; ++run)
+    {
+        for (size_t idx = 0; idx < evict.size(); idx += 64)
+            evict[idx] = uint8_t(evict[idx] + 1);
+        counters.Start();
+        Clock::time_point start = Clock::now();
+        uint64_t cycles = Cycles();
+        sink = sink + calc.compute(data, length, 0);
+        measure.cycles += Cycles() - cycles;
+        counters.Stop(measure);
+        measure.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        measure.bytes += length;
+        measure.runs += 1;
+    }
+    return measure;
+}
+
+/** -----------------------------------------------------
+ * @brief     Output of the results
+ * ------ */
+class Report
+{
+public:
+    Report(OutputFormat format, const char* layout) : format_(format), layout_(layout), first_(true)
+    {
+        if (format_ == csv_format)
+            std::cout << "engine,bits,direction,length,cache,layout,runs,gb_per_s,cycles_per_byte,l1_miss_rate,llc_miss_rate\n";
+        else
+            std::cout << "[\n";
+    }
+
+    ~Report()
+    {
+        if (format_ == json_format)
+            std::cout << (first_? "]\n" : "\n]\n");
+    }
+
+    void Add(const char* engine, int bits, libcrc::ShiftDir dir, size_t length, const char* cache, const Measure& measure)
+    {
+        double gbps = (measure.seconds > 0)? measure.bytes / measure.seconds / 1e9 : 0;
+        double cpb = double(measure.cycles) / measure.bytes;
+        const char* direction = (dir == libcrc::shiftLeft)? "left" : "right";
+
+        std::cout << std::fixed;
+        if (format_ == csv_format)
+        {
+            std::cout << engine << ',' << bits << ',' << direction << ',' << length << ',' << cache << ',' << layout_ << ','
+                      << measure.runs << ',' << std::setprecision(3) << gbps << ',';
+            if (measure.cycles != 0)
+                std::cout << std::setprecision(3) << cpb;
+            std::cout << ',';
+            Rate(measure.l1_misses, measure.l1_reads, "");
+            std::cout << ',';
+            Rate(measure.llc_misses, measure.llc_reads, "");
+            std::cout << std::endl;
+        }
+        else
+        {
+            std::cout << (first_? "  " : ",\n  ")
+                      << "{ \"engine\": \"" << engine << "\", \"bits\": " << bits << ", \"direction\": \"" << direction
+                      << "\", \"length\": " << length << ", \"cache\": \"" << cache << "\", \"layout\": \"" << layout_
+                      << "\", \"runs\": " << measure.runs << ", \"gb_per_s\": " << std::setprecision(3) << gbps
+                      << ", \"cycles_per_byte\": ";
+            if (measure.cycles != 0)
+                std::cout << std::setprecision(3) << cpb;
+            else
+                std::cout << "null";
+            std::cout << ", \"l1_miss_rate\": ";
+            Rate(measure.l1_misses, measure.l1_reads, "null");
+            std::cout << ", \"llc_miss_rate\": ";
+            Rate(measure.llc_misses, measure.llc_reads, "null");
+            std::cout << " }" << std::flush;
+        }
+        first_ = false;
+    }
+
+private:
+    /**
+     * @brief     Writes a miss rate, or `none` if there were no reads counted.
+     */
+    void Rate(uint64_t misses, uint64_t reads, const char* none)
+    {
+        if (reads != 0)
+            std::cout << std::setprecision(4) << double(misses) / reads;
+        else
+            std::cout << none;
+    }
+
+    OutputFormat format_;
+    const char* layout_;
+    bool first_;
+};
+
+/** -----------------------------------------------------
+ * @brief     Context of a benchmark session
+ * ------ */
+struct Bench
+{
+    const Settings& settings;
+    Report& report;
+    const std::vector<uint8_t>& data;
+    std::vector<uint8_t>& evict;
+
+    /**
+     * @brief     Tells whether an engine was selected in the command line.
+     */
+    bool Selected(const char* engine) const
+    {
+        if (settings.engines == nullptr)
+            return true;
+        size_t len = strlen(engine);
+        for (const char* item = settings.engines; item != nullptr; item = strchr(item, ','), item = item? item + 1 : nullptr)
+            if (strncmp(item, engine, len) == 0 && (item[len] == ',' || item[len] == 0))
+                return true;
+        return false;
+    }
+
+    /**
+     * @brief     Runs every length, warm and cold, with a calculator.
+     */
+    template <typename Calc>
+    void Run(const char* engine, int bits, libcrc::ShiftDir dir, const Calc& calc, size_t max_length)
+    {
+        if (!Selected(engine))
+            return;
+        for (size_t length = settings.min_length; length <= std::min(max_length, settings.max_length); length *= 4)
+        {
+            report.Add(engine, bits, dir, length, "warm", MeasureWarm(calc, data.data(), length, settings));
+            report.Add(engine, bits, dir, length, "cold", MeasureCold(calc, data.data(), length, evict, settings));
+        }
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Adapter to run computeParallel as a calculator
+ * ------ */
+template <typename Calc>
+struct ParallelCalc
+{
+    const Calc& calc;
+
+    libcrc::CrcRegister<Calc> compute(const uint8_t* data, size_t length, libcrc::CrcRegister<Calc> seed) const
+    {
+        return libcrc::computeParallel(calc, data, length, seed);
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Adapter to run several calculators as one: each computes its share of the block, so that the tables of
+ *            all of them are in use at once, as with several polynomials in a program.
+ * ------ */
+template <typename Calc, size_t count>
+struct MultiCalc
+{
+    std::vector<Calc> calcs;
+
+    libcrc::CrcRegister<Calc> compute(const uint8_t* data, size_t length, libcrc::CrcRegister<Calc> seed) const
+    {
+        const size_t share = length / count;
+        for (size_t idx = 0; idx < count; ++idx)
+            seed = calcs[idx].compute(data + idx * share, (idx + 1 < count)? share : length - idx * share, seed);
+        return seed;
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Runs every engine for a register size and a shift direction.
+ * ------ */
+template <typename T, libcrc::ShiftDir dir, T poly>
+void RunEngines(Bench& bench)
+{
+    const int bits = sizeof(T) * 8;
+    if ((bench.settings.bits != 0 && bench.settings.bits != bits) || (bench.settings.dir != -1 && bench.settings.dir != dir))
+        return;
+
+    bench.Run("calc", bits, dir, libcrc::CrcCalc<T, dir>(poly), size_t(16) << 20);     // Too slow for longer blocks
+    bench.Run("nibble", bits, dir, libcrc::CrcNibbleCalc<T, dir>(poly), size_t(64) << 20);
+    bench.Run("barrett", bits, dir, libcrc::CrcBarrettCalc<T, dir>(poly), SIZE_MAX);
+    bench.Run("fast", bits, dir, libcrc::CrcFastCalc<T, dir>(poly), SIZE_MAX);
+    bench.Run("slicing4", bits, dir, libcrc::CrcSlicingCalc<T, dir, 4>(poly), SIZE_MAX);
+    bench.Run("slicing8", bits, dir, libcrc::CrcSlicingCalc<T, dir, 8>(poly), SIZE_MAX);
+    bench.Run("slicing16", bits, dir, libcrc::CrcSlicingCalc<T, dir, 16>(poly), SIZE_MAX);
+    using Slicing8 = libcrc::CrcSlicingCalc<T, dir, 8>;
+    bench.Run("slicing8x4", bits, dir, MultiCalc<Slicing8, 4>{ { Slicing8(poly), Slicing8(T(poly ^ 2)), Slicing8(T(poly ^ 4)), Slicing8(T(poly ^ 6)) } }, SIZE_MAX);
+    bench.Run("fast_t", bits, dir, libcrc::CrcFastCalcT<T, dir, poly>(), SIZE_MAX);
+    bench.Run("clmul", bits, dir, libcrc::CrcClmulCalc<T, dir>(poly), SIZE_MAX);
+    libcrc::CrcHwCalc<T, dir> hw(poly);
+    bench.Run("hw", bits, dir, hw, SIZE_MAX);
+    bench.Run("parallel", bits, dir, ParallelCalc<libcrc::CrcHwCalc<T, dir>>{ hw }, SIZE_MAX);
+    bench.Run("auto", bits, dir, libcrc::CrcAutoCalc<T, dir>(poly), SIZE_MAX);
+}
+
+/** ----------------------------------------------------
+ * @brief   Print help and exit.
+ * ------ */
+void Abort(const char* prog)
+{
+    std::cout << prog << " : libcrc++ benchmark.\n"
+        "Syntax: " << prog << " -h | [-o <format>] [-e <engines>] [-b <bits>] [-d <direction>] [-n <length>] [-m <length>]\n"
+        "        [-w <seconds>] [-c <runs>] [-l <length>] [-t <layout>] [-a <alignment>]\n"
+        "  -h : This help\n"
+        "  -o : Output format [csv]\n"
+        "       <format>    : csv, json\n"
+        "  -e : Engines to run [all]\n"
+        "       <engines>   : Comma separated list of calc, nibble, barrett, fast, slicing4, slicing8, slicing16,\n"
+        "                     slicing8x4, fast_t, clmul, hw, parallel, auto\n"
+        "  -b : Register size to run [all]\n"
+        "       <bits>      : 8, 16, 32, 64\n"
+        "  -d : Shift direction to run [both]\n"
+        "       <direction> : l = left, r = right\n"
+        "  -n : Shortest data block [16]\n"
+        "  -m : Longest data block [1G]\n"
+        "       <length>    : Length in bytes; the suffixes K, M and G are accepted\n"
+        "  -w : Minimum measuring time of each warm case [0.1]\n"
+        "  -c : Number of measures of each cold case [5]\n"
+        "  -l : Data written to flush the caches before a cold measure [64M]\n"
+        "  -t : Placement of the lookup tables [aligned]\n"
+        "       <layout>    : aligned = one allocation per polynomial, packed = one after the other,\n"
+        "                     numa = packed, one copy in each NUMA node\n"
+        "  -a : Alignment of the lookup tables, a power of two [64]\n"
+        "\n"
+        "Every data length, from the shortest to the longest in steps of x4, is measured with the data in the caches\n"
+        "(warm) and after flushing them (cold). The 32-bit polynomial is CRC-32C, so that 'hw' uses the CPU instructions.\n"
+        "'slicing8x4' splits the block among four polynomials, to see the effect of the layouts with several tables in\n"
+        "use. The L1 and LLC miss rates are those of the reads, when the kernel allows reading the CPU counters.\n"
+        ;
+    exit(-1);
+}
+
+/**
+ * @brief     Parses a length with an optional K, M or G suffix.
+ */
+size_t ParseLength(const char* text)
+{
+    char* end = nullptr;
+    size_t length = strtoull(text, &end, 0);
+    switch (toupper(*end))
+    {
+        case 'G': length <<= 10;        // Falls through
+        case 'M': length <<= 10;        // Falls through
+        case 'K': length <<= 10;
+    }
+    return length;
+}
+
+/** ----------------------------------------------------
+ * @brief   main
+ * ------*/
+int main(int argc, char* argv[])
+{
+    /*--- Command-line processing ---*/
+    Settings settings;
+    for (bool stop = false; stop == false; )
+    {
+        switch (getopt(argc, argv, "ho:e:b:d:n:m:w:c:l:t:a:"))
+        {
+            case 'h':
+                Abort(argv[0]);
+                break;
+
+            case 'o':
+                if (strcasecmp(optarg, "csv") == 0)
+                    settings.format = csv_format;
+                else if (strcasecmp(optarg, "json") == 0)
+                    settings.format = json_format;
+                else
+                {
+                    std::cerr << "Format " << optarg << " unknown" << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'e':
+                settings.engines = optarg;
+                break;
+
+            case 'b':
+                settings.bits = strtoul(optarg, 0, 0);
+                if (settings.bits != 8 && settings.bits != 16 && settings.bits != 32 && settings.bits != 64)
+                {
+                    std::cerr << "Allowed bit lengths are: 8, 16, 32, 64." << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'd':
+                if (toupper(*optarg) == 'L')
+                    settings.dir = libcrc::shiftLeft;
+                else if (toupper(*optarg) == 'R')
+                    settings.dir = libcrc::shiftRight;
+                else
+                {
+                    std::cerr << "Invalid argument: " << optarg << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'n':
+                settings.min_length = std::max(ParseLength(optarg), size_t(1));
+                break;
+
+            case 'm':
+                settings.max_length = ParseLength(optarg);
+                break;
+
+            case 'w':
+                settings.min_time = strtod(optarg, 0);
+                break;
+
+            case 'c':
+                settings.cold_runs = std::max(1ul, strtoul(optarg, 0, 0));
+                break;
+
+            case 'l':
+                settings.evict_length = ParseLength(optarg);
+                break;
+
+            case 't':
+                settings.layout = optarg;
+                settings.placement.packed = strcasecmp(optarg, "packed") == 0 || strcasecmp(optarg, "numa") == 0;
+                settings.placement.numa_replicas = strcasecmp(optarg, "numa") == 0;
+                if (strcasecmp(optarg, "aligned") != 0 && !settings.placement.packed)
+                {
+                    std::cerr << "Layout " << optarg << " unknown" << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'a':
+                settings.placement.alignment = ParseLength(optarg);
+                if (settings.placement.alignment < libcrc::TableRegistry::alignment
+                    || (settings.placement.alignment & (settings.placement.alignment - 1)) != 0)
+                {
+                    std::cerr << "The alignment must be a power of two, at least " << libcrc::TableRegistry::alignment << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case -1:
+                stop = true;
+                break;
+
+            default:
+                std::cerr << "Invalid argument." << std::endl;
+                exit(-1);
+                break;
+        }
+    }
+
+    /*--- Benchmark data ---*/
+    size_t length = settings.min_length;
+    while (length * 4 <= settings.max_length)
+        length *= 4;
+    std::vector<uint8_t> data(length);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (uint8_t& byte : data)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        byte = uint8_t(state >> 56);
+    }
+    std::vector<uint8_t> evict(settings.evict_length, 0);
+
+    /*--- Do the benchmark ---*/
+    libcrc::TableRegistry::setPlacement(settings.placement);
+    Report report(settings.format, settings.layout);
+    Bench bench = { settings, report, data, evict };
+    RunEngines<uint8_t,  libcrc::shiftLeft,  0x07>(bench);
+    RunEngines<uint8_t,  libcrc::shiftRight, 0x07>(bench);
+    RunEngines<uint16_t, libcrc::shiftLeft,  0x1021>(bench);
+    RunEngines<uint16_t, libcrc::shiftRight, 0x1021>(bench);
+    RunEngines<uint32_t, libcrc::shiftLeft,  0x1EDC6F41>(bench);
+    RunEngines<uint32_t, libcrc::shiftRight, 0x1EDC6F41>(bench);
+    RunEngines<uint64_t, libcrc::shiftLeft,  0x42F0E1EBA9EA3693>(bench);
+    RunEngines<uint64_t, libcrc::shiftRight, 0x42F0E1EBA9EA3693>(bench);
+}
@@ -0,0 +1,495 @@
+/**
+ * @package   libcrc++: C++ library for universal CRC calculation.
+ * @brief     Library self-check: every engine against the bitwise CrcCalc, for every register size, direction and
+ *            data length up to 2 KB, plus the catalogue, combine(), update(), CrcWidthCalc, verifyRecords and
+ *            PolySearch. Prints the mismatches and exits with a nonzero status if there is any.
+ * @author    José Luis Sánchez Arroyo
+ * @section   License
+ * Copyright (c) 2017 - 2025 José Luis Sánchez Arroyo
+ * This software is distributed under the terms of the MIT license and comes WITHOUT ANY WARRANTY.
+ * Please read the file LICENSE for further details.
+ */
+
+#include "libcrc++.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr size_t max_length = 2048;                     // Longest data block checked
+constexpr size_t all_lengths = 512;                     // Every length is checked up to this one, then in steps
+constexpr size_t length_step = 7;                       // Step of the longer lengths, odd to vary the tails
+constexpr size_t data_offset = 3;                       // Misalignment of the data in the second pass
+
+/** -----------------------------------------------------
+ * @brief     Results of the checks
+ * ------ */
+struct Report
+{
+    size_t checks = 0;
+    size_t failures = 0;
+
+    /**
+     * @brief     Counts a check and prints it if it failed.
+     */
+    void Expect(bool good, const std::string& what)
+    {
+        ++checks;
+        if (!good)
+        {
+            ++failures;
+            if (failures <= 100)
+                std::cerr << "FAILED: " << what << std::endl;
+        }
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Hexadecimal text of a register of any size.
+ * ------ */
+template <typename T>
+std::string Hex(T value)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    std::string text;
+    for (int nibble = int(sizeof(T) * 2) - 1; nibble >= 0; --nibble)
+        text += digits[unsigned(value >> (nibble * 4)) & 0x0F];
+    return text;
+}
+
+/** -----------------------------------------------------
+ * @brief     Seed of the second pass: 0xA5 in every byte.
+ * ------ */
+template <typename T>
+constexpr T Pattern()
+{
+    return T(T(~T(0)) / 0xFF * 0xA5);
+}
+
+/** -----------------------------------------------------
+ * @brief     Lengths checked: all of them up to all_lengths, then in steps up to max_length.
+ * ------ */
+std::vector<size_t> Lengths()
+{
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= max_length; length += (length < all_lengths)? 1 : length_step)
+        lengths.push_back(length);
+    lengths.push_back(max_length);
+    return lengths;
+}
+
+/** -----------------------------------------------------
+ * @brief     Context of the checks of a register size, direction and polynomial
+ * ------ */
+template <typename T, libcrc::ShiftDir dir>
+struct Context
+{
+    Report& report;
+    const std::vector<uint8_t>& data;
+    const std::vector<size_t>& lengths;
+    T poly;
+    std::vector<T> reference[2];                        // CRC of every prefix, from CrcCalc, for each pass
+
+    /**
+     * @brief     Computes the reference CRCs one byte at a time, checking a few of them in a single call.
+     */
+    Context(Report& rep, const std::vector<uint8_t>& bytes, const std::vector<size_t>& lens, T polynomial)
+      : report(rep), data(bytes), lengths(lens), poly(polynomial)
+    {
+        const libcrc::CrcCalc<T, dir> calc(poly);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const uint8_t* block = data.data() + Offset(pass);
+            reference[pass].push_back(Seed(pass));
+            for (size_t length = 1; length <= max_length; ++length)
+                reference[pass].push_back(calc.compute(block + length - 1, 1, reference[pass].back()));
+            for (size_t length : { size_t(1), size_t(64), max_length })
+                report.Expect(calc.compute(block, length, Seed(pass)) == reference[pass][length], Label("calc", pass, length));
+        }
+    }
+
+    static size_t Offset(int pass) { return (pass == 0)? 0 : data_offset; }
+
+    static T Seed(int pass) { return (pass == 0)? T(0) : Pattern<T>(); }
+
+    std::string Label(const std::string& engine, int pass, size_t length) const
+    {
+        return engine + " " + std::to_string(sizeof(T) * 8) + " bits " + ((dir == libcrc::shiftLeft)? "left" : "right")
+             + " poly " + Hex(poly) + " length " + std::to_string(length) + " offset " + std::to_string(Offset(pass));
+    }
+
+    /**
+     * @brief     Checks compute() of a calculator at every length, aligned with seed 0 and misaligned with a seed.
+     */
+    template <typename Calc>
+    void Compute(const std::string& engine, const Calc& calc)
+    {
+        for (int pass = 0; pass < 2; ++pass)
+            for (size_t length : lengths)
+            {
+                T crc = calc.compute(data.data() + Offset(pass), length, Seed(pass));
+                report.Expect(crc == reference[pass][length], Label(engine, pass, length) + ": " + Hex(crc)
+                                                              + " instead of " + Hex(reference[pass][length]));
+            }
+    }
+
+    /**
+     * @brief     Checks combine() and update() of a calculator at random split points.
+     */
+    template <typename Calc>
+    void CombineUpdate(const std::string& engine, const Calc& calc, std::mt19937& random)
+    {
+        const uint8_t* block = data.data() + data_offset;
+        for (int round = 0; round < 64; ++round)
+        {
+            size_t length = random() % (max_length + 1);
+            size_t split = random() % (length + 1);
+            T seedB = (round % 2 == 0)? T(0) : Pattern<T>();
+            T crcA = calc.compute(block, split, Pattern<T>());
+            T crcB = calc.compute(block + split, length - split, seedB);
+            report.Expect(calc.combine(crcA, crcB, length - split, seedB) == reference[1][length],
+                          Label(engine + " combine", 1, length) + " split " + std::to_string(split));
+
+            size_t count = random() % (length - split + 1) % 16;
+            std::vector<uint8_t> changed(block, block + length);
+            std::vector<uint8_t> bytes(count);
+            for (uint8_t& byte : bytes)
+                byte = uint8_t(random());
+            std::copy(bytes.begin(), bytes.end(), changed.begin() + split);
+            report.Expect(calc.update(reference[1][length], length, split, block + split, bytes.data(), count)
+                          == calc.compute(changed.data(), length, Pattern<T>()),
+                          Label(engine + " update", 1, length) + " at " + std::to_string(split) + " count " + std::to_string(count));
+        }
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Adapter to run computeParallel as a calculator, in chunks short enough to split the blocks checked
+ * ------ */
+template <typename Calc>
+struct ParallelCalc
+{
+    Calc calc;
+
+    libcrc::CrcRegister<Calc> compute(const uint8_t* data, size_t length, libcrc::CrcRegister<Calc> seed) const
+    {
+        libcrc::ParallelOptions options;
+        options.threads = 3;
+        options.threshold = 0;
+        options.chunk = 100;
+        return libcrc::computeParallel(calc, data, length, seed, options);
+    }
+};
+
+/** -----------------------------------------------------
+ * @brief     Checks the engines of registers up to 64 bits: carry-less multiplication, Barrett and CRC instructions.
+ * ------ */
+template <typename T, libcrc::ShiftDir dir>
+void CheckNarrowEngines(Context<T, dir>& context, std::mt19937& random, std::true_type)
+{
+    context.Compute("barrett", libcrc::CrcBarrettCalc<T, dir>(context.poly));
+    context.Compute("clmul", libcrc::CrcClmulCalc<T, dir>(context.poly, false));
+    context.Compute("clmul-avx512", libcrc::CrcClmulCalc<T, dir>(context.poly, true));
+    context.Compute("hardware", libcrc::CrcHwCalc<T, dir>(context.poly));
+    context.CombineUpdate("clmul", libcrc::CrcClmulCalc<T, dir>(context.poly), random);
+    context.CombineUpdate("hardware", libcrc::CrcHwCalc<T, dir>(context.poly), random);
+}
+
+template <typename T, libcrc::ShiftDir dir>
+void CheckNarrowEngines(Context<T, dir>&, std::mt19937&, std::false_type)
+{ }
+
+/** -----------------------------------------------------
+ * @brief     Checks every engine for a register size, a shift direction and a polynomial.
+ * ------ */
+template <typename T, libcrc::ShiftDir dir, T poly>
+void CheckEngines(Report& report, const std::vector<uint8_t>& data, const std::vector<size_t>& lengths, std::mt19937& random)
+{
+    Context<T, dir> context(report, data, lengths, poly);
+    context.Compute("nibble", libcrc::CrcNibbleCalc<T, dir>(poly));
+    context.Compute("fast", libcrc::CrcFastCalc<T, dir>(poly));
+    context.Compute("fast-owned", libcrc::CrcFastCalc<T, dir>(poly, libcrc::tablesOwned));
+    context.Compute("slicing4", libcrc::CrcSlicingCalc<T, dir, 4>(poly));
+    context.Compute("slicing8", libcrc::CrcSlicingCalc<T, dir, 8>(poly));
+    context.Compute("slicing16", libcrc::CrcSlicingCalc<T, dir, 16>(poly));
+    context.Compute("slicing8-owned", libcrc::CrcSlicingCalc<T, dir, 8>(poly, libcrc::tablesOwned));
+    context.Compute("fast_t1", libcrc::CrcFastCalcT<T, dir, poly, 1>());
+    context.Compute("fast_t8", libcrc::CrcFastCalcT<T, dir, poly, 8>());
+    context.Compute("fast_t16", libcrc::CrcFastCalcT<T, dir, poly, 16>());
+    context.Compute("parallel", ParallelCalc<libcrc::CrcSlicingCalc<T, dir, 8>>{ libcrc::CrcSlicingCalc<T, dir, 8>(poly) });
+
+    static const libcrc::CrcEngine engines[] = { libcrc::engineAuto, libcrc::engineBitwise, libcrc::engineNibble,
+                                                 libcrc::engineBarrett, libcrc::engineTable, libcrc::engineSlicing,
+                                                 libcrc::engineClmul, libcrc::engineClmulWide, libcrc::engineHardware };
+    for (libcrc::CrcEngine engine : engines)
+        context.Compute(std::string("auto/") + libcrc::engineName(engine), libcrc::CrcAutoCalc<T, dir>(poly, engine));
+
+    context.CombineUpdate("calc", libcrc::CrcCalc<T, dir>(poly), random);
+    context.CombineUpdate("slicing8", libcrc::CrcSlicingCalc<T, dir, 8>(poly), random);
+    context.CombineUpdate("fast_t8", libcrc::CrcFastCalcT<T, dir, poly, 8>(), random);
+    context.CombineUpdate("auto", libcrc::CrcAutoCalc<T, dir>(poly), random);
+    CheckNarrowEngines(context, random, std::integral_constant<bool, sizeof(T) <= sizeof(uint64_t)>());
+}
+
+/** -----------------------------------------------------
+ * @brief     Writes a CRC after a block as the algorithm appends it: little endian if refout, big endian otherwise.
+ * ------ */
+template <typename Algo>
+void AppendCrc(uint8_t* where, typename Algo::Type crc)
+{
+    const size_t bytes = Algo::width / 8;
+    for (size_t idx = 0; idx < bytes; ++idx)
+        where[idx] = uint8_t(crc >> (8 * (Algo::refout? idx : bytes - 1 - idx)));
+}
+
+/** -----------------------------------------------------
+ * @brief     Checks the blocks followed by their CRC of a whole-byte algorithm: residue, verify and verifyRecords.
+ * ------ */
+template <typename Algo>
+void CheckResidue(Report& report, const std::vector<uint8_t>& data, std::mt19937& random, std::true_type)
+{
+    using Crc = libcrc::Crc<Algo>;
+    const size_t bytes = Algo::width / 8;
+    const std::string name = Algo::name();
+
+    std::vector<uint8_t> block(data.begin(), data.begin() + 100 + bytes);
+    for (size_t length : { size_t(0), size_t(9), size_t(100) })
+    {
+        AppendCrc<Algo>(block.data() + length, Crc::compute(block.data(), length));
+        report.Expect(Crc::Engine::compute(block.data(), length + bytes, Crc::seed) == Crc::residue, name + " residue");
+        report.Expect(Crc::verify(block.data(), length + bytes), name + " Crc::verify");
+        report.Expect(libcrc::verify<Algo>(block.data(), length + bytes), name + " verify");
+        block[length / 2] ^= 0x10;
+        report.Expect(!Crc::verify(block.data(), length + bytes), name + " Crc::verify of a wrong block");
+        report.Expect(!libcrc::verify<Algo>(block.data(), length + bytes), name + " verify of a wrong block");
+        block[length / 2] ^= 0x10;
+    }
+
+    const size_t count = 150;
+    for (size_t recordSize : { bytes, bytes + 1, bytes + 16, bytes + 67, size_t(1100) })
+        for (size_t trailer : { size_t(0), size_t(3) })
+        {
+            if (recordSize < bytes + trailer)
+                continue;
+            const size_t crcOffset = recordSize - bytes - trailer;
+            std::vector<uint8_t> records(recordSize * count);
+            std::vector<uint64_t> expected((count + 63) / 64);
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                uint8_t* record = records.data() + idx * recordSize;
+                for (size_t pos = 0; pos < recordSize; ++pos)
+                    record[pos] = uint8_t(random());
+                AppendCrc<Algo>(record + crcOffset, Crc::compute(record, crcOffset));
+                if (idx % 7 == 3)
+                {
+                    record[random() % (crcOffset + bytes)] ^= uint8_t(1 << (random() % 8));
+                    expected[idx / 64] |= uint64_t(1) << (idx % 64);
+                }
+            }
+            std::vector<uint64_t> bitmap((count + 63) / 64, ~uint64_t(0));
+            size_t wrong = libcrc::verifyRecords<Algo>(records.data(), recordSize, count, crcOffset, bitmap.data());
+            report.Expect(wrong == (count + 3) / 7 && bitmap == expected,
+                          name + " verifyRecords of " + std::to_string(recordSize) + " bytes, CRC at " + std::to_string(crcOffset));
+        }
+    std::vector<uint64_t> bitmap(1);
+    report.Expect(libcrc::verifyRecords<Algo>(data.data(), bytes + 1, 10, 2, bitmap.data()) == 10 && bitmap[0] == 0x3FF,
+                  name + " verifyRecords without room for the CRC");
+}
+
+template <typename Algo>
+void CheckResidue(Report&, const std::vector<uint8_t>&, std::mt19937&, std::false_type)
+{ }
+
+/** -----------------------------------------------------
+ * @brief     Checks the catalogue values of an algorithm.
+ * ------ */
+template <typename Algo>
+void CheckModel(Report& report, const std::vector<uint8_t>& data, std::mt19937& random)
+{
+    const std::string name = Algo::name();
+    const uint8_t* check = reinterpret_cast<const uint8_t*>("123456789");
+    report.Expect(libcrc::Crc<Algo>::compute("123456789", 9) == Algo::check, name + " check");
+    report.Expect(libcrc::Crc<Algo, 1>::compute(check, 9) == Algo::check, name + " check with 1 table");
+    report.Expect(libcrc::Crc<Algo, 16>::compute(check, 9) == Algo::check, name + " check with 16 tables");
+    report.Expect(libcrc::Crc<Algo>().update(check, 4).update(check + 4, 5).finalize() == Algo::check, name + " check in two parts");
+    CheckResidue<Algo>(report, data, random, std::integral_constant<bool, Algo::width % 8 == 0 && sizeof(typename Algo::Type) <= sizeof(uint64_t)>());
+}
+
+/** -----------------------------------------------------
+ * @brief     Checks CrcWidthCalc over a calculator against the engine of Crc, which keeps the register shifted.
+ * ------ */
+template <typename Algo, typename Calc, typename... Args>
+void CheckWidth(Report& report, const std::vector<uint8_t>& data, const std::vector<size_t>& lengths, const std::string& engine, Args... args)
+{
+    using Crc = libcrc::Crc<Algo>;
+    using Type = typename Algo::Type;
+    const bool left = !Algo::refin;
+    const std::string name = std::string(Algo::name()) + " width " + engine;
+    auto toWidth = [left](Type reg) { return left? Type(reg >> Crc::shift) : reg; };
+    auto fromWidth = [left](Type crc) { return left? Type(crc << Crc::shift) : crc; };
+
+    const libcrc::CrcWidthCalc<Calc> calc(Algo::poly, Algo::width, args...);
+    const Type seed = toWidth(Crc::seed);
+    report.Expect(calc.getWidth() == Algo::width, name + " getWidth");
+    report.Expect(Crc::finish(fromWidth(calc.compute(reinterpret_cast<const uint8_t*>("123456789"), 9, seed))) == Algo::check, name + " check");
+    for (size_t length : lengths)
+    {
+        Type expected = toWidth(Crc::Engine::compute(data.data(), length, Crc::seed));
+        report.Expect(calc.compute(data.data(), length, seed) == expected, name + " length " + std::to_string(length));
+        if (length % 64 == 5)
+        {
+            size_t split = length / 3;
+            Type crcA = calc.compute(data.data(), split, seed);
+            Type crcB = calc.compute(data.data() + split, length - split, 0);
+            report.Expect(calc.combine(crcA, crcB, length - split) == expected, name + " combine length " + std::to_string(length));
+            uint8_t bytes[2] = { uint8_t(~data[split]), uint8_t(~data[split + 1]) };
+            std::vector<uint8_t> changed(data.begin(), data.begin() + length);
+            std::copy(bytes, bytes + 2, changed.begin() + split);
+            report.Expect(calc.update(expected, length, split, data.data() + split, bytes, 2) == calc.compute(changed.data(), length, seed),
+                          name + " update length " + std::to_string(length));
+        }
+    }
+}
+
+/** -----------------------------------------------------
+ * @brief     Checks CrcWidthCalc for an algorithm narrower than its register, over every engine.
+ * ------ */
+template <typename Algo, typename T = typename Algo::Type, libcrc::ShiftDir dir = Algo::refin? libcrc::shiftRight : libcrc::shiftLeft>
+void CheckWidthEngines(Report& report, const std::vector<uint8_t>& data, const std::vector<size_t>& lengths, std::true_type)
+{
+    CheckWidth<Algo, libcrc::CrcClmulCalc<T, dir>>(report, data, lengths, "clmul");
+    CheckWidth<Algo, libcrc::CrcHwCalc<T, dir>>(report, data, lengths, "hardware");
+}
+
+template <typename Algo>
+void CheckWidthEngines(Report&, const std::vector<uint8_t>&, const std::vector<size_t>&, std::false_type)
+{ }
+
+template <typename Algo, typename T = typename Algo::Type, libcrc::ShiftDir dir = Algo::refin? libcrc::shiftRight : libcrc::shiftLeft>
+void CheckWidthModel(Report& report, const std::vector<uint8_t>& data, const std::vector<size_t>& lengths)
+{
+    CheckWidth<Algo, libcrc::CrcCalc<T, dir>>(report, data, lengths, "calc");
+    CheckWidth<Algo, libcrc::CrcFastCalc<T, dir>>(report, data, lengths, "fast");
+    CheckWidth<Algo, libcrc::CrcSlicingCalc<T, dir, 16>>(report, data, lengths, "slicing16");
+    CheckWidth<Algo, libcrc::CrcAutoCalc<T, dir>>(report, data, lengths, "auto");
+    CheckWidthEngines<Algo>(report, data, lengths, std::integral_constant<bool, sizeof(T) <= sizeof(uint64_t)>());
+}
+
+/** -----------------------------------------------------
+ * @brief     Hamming distance of a CRC by brute force: lowest weight of the codewords, up to limit + 1.
+ * @desc      The codewords of m message bits are the multiples of x^width + poly of less than m + width bits.
+ * ------ */
+unsigned BruteDistance(unsigned width, uint64_t poly, size_t messageBits, unsigned limit)
+{
+    const uint64_t generator = (uint64_t(1) << width) | poly;
+    unsigned lowest = limit + 1;
+    for (uint64_t quotient = 1; quotient < (uint64_t(1) << messageBits); ++quotient)
+    {
+        uint64_t codeword = 0;
+        for (unsigned bit = 0; bit < messageBits; ++bit)
+            if ((quotient >> bit) & 1)
+                codeword ^= generator << bit;
+        unsigned weight = 0;
+        for (; codeword != 0; codeword &= codeword - 1)
+            ++weight;
+        lowest = std::min(lowest, weight);
+    }
+    return lowest;
+}
+
+/** -----------------------------------------------------
+ * @brief     Checks PolySearch against brute force: every 8-bit polynomial, and a few 16-bit ones.
+ * ------ */
+void CheckPolySearch(Report& report)
+{
+    const std::vector<size_t> short_lengths = { 3, 8, 16 };
+    const libcrc::PolySearch search8(8, short_lengths);
+    std::vector<libcrc::PolySearch::Result> found = search8.run(0, 0xFF, 0, 2);
+    report.Expect(found.size() == 128, "PolySearch of 8 bits: " + std::to_string(found.size()) + " polynomials");
+    for (const libcrc::PolySearch::Result& result : found)
+        for (size_t idx = 0; idx < short_lengths.size(); ++idx)
+            report.Expect(result.distances[idx] == BruteDistance(8, result.poly, short_lengths[idx], 6),
+                          "PolySearch of " + Hex(uint8_t(result.poly)) + " at " + std::to_string(short_lengths[idx]) + " bits");
+
+    const std::vector<size_t> long_lengths = { 12, 20 };
+    const libcrc::PolySearch search16(16, long_lengths);
+    for (uint64_t poly : { 0x1021, 0x8005, 0x3D65, 0x0589 })
+    {
+        std::vector<unsigned> distances = search16.distances(poly);
+        for (size_t idx = 0; idx < long_lengths.size(); ++idx)
+            report.Expect(distances[idx] == BruteDistance(16, poly, long_lengths[idx], 6),
+                          "PolySearch of " + Hex(uint16_t(poly)) + " at " + std::to_string(long_lengths[idx]) + " bits");
+    }
+}
+
+/** ----------------------------------------------------
+ * @brief   Main
+ * ------ */
+int main()
+{
+    Report report;
+    std::mt19937 random(2017);
+    std::vector<uint8_t> data(max_length + data_offset);
+    for (uint8_t& byte : data)
+        byte = uint8_t(random());
+    const std::vector<size_t> lengths = Lengths();
+
+    /*--- Every engine against CrcCalc ---*/
+    CheckEngines<uint8_t,  libcrc::shiftLeft,  0x07>(report, data, lengths, random);
+    CheckEngines<uint8_t,  libcrc::shiftRight, 0x31>(report, data, lengths, random);
+    CheckEngines<uint16_t, libcrc::shiftLeft,  0x1021>(report, data, lengths, random);
+    CheckEngines<uint16_t, libcrc::shiftRight, 0x8005>(report, data, lengths, random);
+    CheckEngines<uint32_t, libcrc::shiftLeft,  0x04C11DB7>(report, data, lengths, random);
+    CheckEngines<uint32_t, libcrc::shiftRight, 0x04C11DB7>(report, data, lengths, random);
+    CheckEngines<uint32_t, libcrc::shiftLeft,  0x1EDC6F41>(report, data, lengths, random);
+    CheckEngines<uint32_t, libcrc::shiftRight, 0x1EDC6F41>(report, data, lengths, random);
+    CheckEngines<uint64_t, libcrc::shiftLeft,  0x42F0E1EBA9EA3693>(report, data, lengths, random);
+    CheckEngines<uint64_t, libcrc::shiftRight, 0x42F0E1EBA9EA3693>(report, data, lengths, random);
+    CheckEngines<uint64_t, libcrc::shiftRight, 0x000000000000001B>(report, data, lengths, random);
+#if defined(LIBCRC_INT128)
+    CheckEngines<libcrc::uint128_t, libcrc::shiftLeft,  0x87>(report, data, lengths, random);
+    CheckEngines<libcrc::uint128_t, libcrc::shiftRight, 0x87>(report, data, lengths, random);
+#endif
+
+    /*--- Catalogue ---*/
+    CheckModel<libcrc::Crc5Usb>(report, data, random);
+    CheckModel<libcrc::Crc8Smbus>(report, data, random);
+    CheckModel<libcrc::Crc8MaximDow>(report, data, random);
+    CheckModel<libcrc::Crc8Autosar>(report, data, random);
+    CheckModel<libcrc::Crc15Can>(report, data, random);
+    CheckModel<libcrc::Crc16Arc>(report, data, random);
+    CheckModel<libcrc::Crc16Modbus>(report, data, random);
+    CheckModel<libcrc::Crc16Usb>(report, data, random);
+    CheckModel<libcrc::Crc16Ibm3740>(report, data, random);
+    CheckModel<libcrc::Crc16Xmodem>(report, data, random);
+    CheckModel<libcrc::Crc16Kermit>(report, data, random);
+    CheckModel<libcrc::Crc16IbmSdlc>(report, data, random);
+    CheckModel<libcrc::Crc16Genibus>(report, data, random);
+    CheckModel<libcrc::Crc24OpenPgp>(report, data, random);
+    CheckModel<libcrc::Crc32IsoHdlc>(report, data, random);
+    CheckModel<libcrc::Crc32Iscsi>(report, data, random);
+    CheckModel<libcrc::Crc32Bzip2>(report, data, random);
+    CheckModel<libcrc::Crc32Mpeg2>(report, data, random);
+    CheckModel<libcrc::Crc32Cksum>(report, data, random);
+    CheckModel<libcrc::Crc64Xz>(report, data, random);
+    CheckModel<libcrc::Crc64Ecma182>(report, data, random);
+    CheckModel<libcrc::Crc64GoIso>(report, data, random);
+    CheckModel<libcrc::Crc64We>(report, data, random);
+#if defined(LIBCRC_INT128)
+    CheckModel<libcrc::Crc82Darc>(report, data, random);
+#endif
+
+    /*--- CRCs narrower than the register ---*/
+    CheckWidthModel<libcrc::Crc5Usb>(report, data, lengths);
+    CheckWidthModel<libcrc::Crc15Can>(report, data, lengths);
+    CheckWidthModel<libcrc::Crc24OpenPgp>(report, data, lengths);
+#if defined(LIBCRC_INT128)
+    CheckWidthModel<libcrc::Crc82Darc>(report, data, lengths);
+#endif
+
+    /*--- Polynomial search ---*/
+    CheckPolySearch(report);
+
+    std::cout << report.checks << " checks, " << report.failures << " failures" << std::endl;
+    return (report.failures == 0)? 0 : 1;
+}
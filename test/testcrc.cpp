@@ -9,9 +9,24 @@
  */
 
 #include "libcrc++.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
 #include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>         // getopt
 
 enum PrintStyles
@@ -19,9 +34,31 @@ enum PrintStyles
     no_style,
     c_style,
     dec_style,
-    hex_style
+    hex_style,
+    header_style
 };
 
+enum ReadModes
+{
+    read_mode,                                          // Plain reads into a large buffer
+    mmap_mode,                                          // File mapped in memory
+    async_mode                                          // Double buffer filled by a reader thread
+};
+
+enum OutputStyles
+{
+    text_output,                                        // Report of every file
+    sum_output,                                         // "<crc>  <file>" lines, as sha256sum
+    json_output                                         // A JSON object per line
+};
+
+constexpr size_t read_buffer = size_t(1) << 20;         // Buffer of read_mode
+constexpr size_t async_buffer = size_t(4) << 20;        // Each of the two buffers of async_mode
+constexpr size_t map_window = size_t(4) << 20;          // mmap_mode computes a window while the next one is read ahead
+constexpr uint64_t split_chunk = uint64_t(64) << 20;    // Longer files are split in chunks computed in parallel
+constexpr uint64_t to_end = UINT64_MAX;                 // Length of the data up to the end of the file
+constexpr unsigned header_slices = 16;                  // Lookup tables in a generated header: slicing-by-16
+
 /**
  * @brief     Banner
  */
@@ -47,39 +84,68 @@ public:
 
     uint64_t
     compute(
-        uint8_t* data,
+        const uint8_t* data,
         size_t size,
         uint64_t seed
-    );
+    ) const;
+
+    uint64_t
+    combine(
+        uint64_t crc_a,
+        uint64_t crc_b,
+        uint64_t length_b
+    ) const;
 
 private:
-    libcrc::CrcFastCalc<uint8_t,  libcrc::shiftLeft>  calc_8_l;
-    libcrc::CrcFastCalc<uint16_t, libcrc::shiftLeft>  calc_16_l;
-    libcrc::CrcFastCalc<uint32_t, libcrc::shiftLeft>  calc_32_l;
-    libcrc::CrcFastCalc<uint64_t, libcrc::shiftLeft>  calc_64_l;
-    libcrc::CrcFastCalc<uint8_t,  libcrc::shiftRight> calc_8_r;
-    libcrc::CrcFastCalc<uint16_t, libcrc::shiftRight> calc_16_r;
-    libcrc::CrcFastCalc<uint32_t, libcrc::shiftRight> calc_32_r;
-    libcrc::CrcFastCalc<uint64_t, libcrc::shiftRight> calc_64_r;
+    template <typename T, libcrc::ShiftDir dir>
+    using Calc = libcrc::CrcWidthCalc<libcrc::CrcAutoCalc<T, dir>>;         // Any width, in the smallest register
+
+    std::unique_ptr<Calc<uint8_t,  libcrc::shiftLeft>>  calc_8_l;           // Only the selected calculator is created
+    std::unique_ptr<Calc<uint16_t, libcrc::shiftLeft>>  calc_16_l;
+    std::unique_ptr<Calc<uint32_t, libcrc::shiftLeft>>  calc_32_l;
+    std::unique_ptr<Calc<uint64_t, libcrc::shiftLeft>>  calc_64_l;
+    std::unique_ptr<Calc<uint8_t,  libcrc::shiftRight>> calc_8_r;
+    std::unique_ptr<Calc<uint16_t, libcrc::shiftRight>> calc_16_r;
+    std::unique_ptr<Calc<uint32_t, libcrc::shiftRight>> calc_32_r;
+    std::unique_ptr<Calc<uint64_t, libcrc::shiftRight>> calc_64_r;
 
     int selector;
 };
 
 CrcWrapper::CrcWrapper(int p_bits, libcrc::ShiftDir p_dir, uint64_t p_poly)
-   : calc_8_l(p_poly), calc_16_l(p_poly), calc_32_l(p_poly), calc_64_l(p_poly), calc_8_r(p_poly), calc_16_r(p_poly), calc_32_r(p_poly), calc_64_r(p_poly)
 {
-    switch (p_bits)
+    int register_bits = (p_bits <= 8)? 8 : (p_bits <= 16)? 16 : (p_bits <= 32)? 32 : 64;
+    selector = register_bits + (p_dir == libcrc::shiftLeft? 0 : 1);
+    switch (selector)
     {
         case 8:
+            calc_8_l.reset(new Calc<uint8_t, libcrc::shiftLeft>(p_poly, p_bits));
+            break;
         case 16:
+            calc_16_l.reset(new Calc<uint16_t, libcrc::shiftLeft>(p_poly, p_bits));
+            break;
         case 32:
+            calc_32_l.reset(new Calc<uint32_t, libcrc::shiftLeft>(p_poly, p_bits));
+            break;
         case 64:
+            calc_64_l.reset(new Calc<uint64_t, libcrc::shiftLeft>(p_poly, p_bits));
+            break;
+        case 9:
+            calc_8_r.reset(new Calc<uint8_t, libcrc::shiftRight>(p_poly, p_bits));
+            break;
+        case 17:
+            calc_16_r.reset(new Calc<uint16_t, libcrc::shiftRight>(p_poly, p_bits));
+            break;
+        case 33:
+            calc_32_r.reset(new Calc<uint32_t, libcrc::shiftRight>(p_poly, p_bits));
+            break;
+        case 65:
+            calc_64_r.reset(new Calc<uint64_t, libcrc::shiftRight>(p_poly, p_bits));
             break;
         default:
             std::cerr << "CRC calculation of " << p_bits << " is not supported.\n\n";
             exit(-1);
     }
-    selector = p_bits + (p_dir == libcrc::shiftLeft? 0 : 1);
 }
 
 const uint8_t* CrcWrapper::getLookupTable()
@@ -87,47 +153,73 @@ const uint8_t* CrcWrapper::getLookupTable()
     switch (selector)
     {
         case 8:
-            return reinterpret_cast<const uint8_t*>(calc_8_l.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_8_l->engine().getLookupTable());
         case 16:
-            return reinterpret_cast<const uint8_t*>(calc_16_l.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_16_l->engine().getLookupTable());
         case 32:
-            return reinterpret_cast<const uint8_t*>(calc_32_l.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_32_l->engine().getLookupTable());
         case 64:
-            return reinterpret_cast<const uint8_t*>(calc_64_l.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_64_l->engine().getLookupTable());
         case 9:
-            return reinterpret_cast<const uint8_t*>(calc_8_r.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_8_r->engine().getLookupTable());
         case 17:
-            return reinterpret_cast<const uint8_t*>(calc_16_r.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_16_r->engine().getLookupTable());
         case 33:
-            return reinterpret_cast<const uint8_t*>(calc_32_r.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_32_r->engine().getLookupTable());
         case 65:
-            return reinterpret_cast<const uint8_t*>(calc_64_r.getLookupTable());
+            return reinterpret_cast<const uint8_t*>(calc_64_r->engine().getLookupTable());
     }
     std::cerr << "Invalid selector: " << selector << std::endl;
     exit(-1);
     return 0;
 }
 
-uint64_t CrcWrapper::compute(uint8_t* data, size_t size, uint64_t seed)
+uint64_t CrcWrapper::compute(const uint8_t* data, size_t size, uint64_t seed) const
+{
+  switch (selector)
+  {
+      case 8:
+          return calc_8_l->compute(data, size, seed);
+      case 16:
+          return calc_16_l->compute(data, size, seed);
+      case 32:
+          return calc_32_l->compute(data, size, seed);
+      case 64:
+          return calc_64_l->compute(data, size, seed);
+      case 9:
+          return calc_8_r->compute(data, size, seed);
+      case 17:
+          return calc_16_r->compute(data, size, seed);
+      case 33:
+          return calc_32_r->compute(data, size, seed);
+      case 65:
+          return calc_64_r->compute(data, size, seed);
+  }
+  std::cerr << "Invalid selector: " << selector << std::endl;
+  exit(-1);
+  return 0;
+}
+
+uint64_t CrcWrapper::combine(uint64_t crc_a, uint64_t crc_b, uint64_t length_b) const
 {
   switch (selector)
   {
       case 8:
-          return calc_8_l.compute(data, size, seed);
+          return calc_8_l->combine(crc_a, crc_b, length_b);
       case 16:
-          return calc_16_l.compute(data, size, seed);
+          return calc_16_l->combine(crc_a, crc_b, length_b);
       case 32:
-          return calc_32_l.compute(data, size, seed);
+          return calc_32_l->combine(crc_a, crc_b, length_b);
       case 64:
-          return calc_64_l.compute(data, size, seed);
+          return calc_64_l->combine(crc_a, crc_b, length_b);
       case 9:
-          return calc_8_r.compute(data, size, seed);
+          return calc_8_r->combine(crc_a, crc_b, length_b);
       case 17:
-          return calc_16_r.compute(data, size, seed);
+          return calc_16_r->combine(crc_a, crc_b, length_b);
       case 33:
-          return calc_32_r.compute(data, size, seed);
+          return calc_32_r->combine(crc_a, crc_b, length_b);
       case 65:
-          return calc_64_r.compute(data, size, seed);
+          return calc_64_r->combine(crc_a, crc_b, length_b);
   }
   std::cerr << "Invalid selector: " << selector << std::endl;
   exit(-1);
@@ -204,40 +296,515 @@ void GenerateTable(PrintStyles style, int bits, libcrc::ShiftDir dir, uint64_t p
         std::cout << "};\n";
 }
 
+/** ----------------------------------------------------
+ * @brief     Write a list of values as the body of a C array.
+ * ------ */
+template <typename T>
+void WriteValues(const T* values, size_t count, int width, const char* indent)
+{
+    for (size_t ix = 0; ix < count; ++ix)
+        std::cout << (ix % 8 == 0? indent : "") << "0x" << std::setw(width) << static_cast<uint64_t>(values[ix])
+                  << (ix + 1 < count? "," : "") << (ix % 8 == 7 || ix + 1 == count? "\n" : " ");
+}
+
+/** ----------------------------------------------------
+ * @brief     Write a header with the constants of every engine, ready to compile into a program.
+ * @desc      Everything is constexpr and aligned to a cache line. When libcrc++.h is included first, the header also
+ *            defines the ClmulConstants of the polynomial and preload(), which hands the tables to the TableRegistry.
+ * ------ */
+template <typename T, libcrc::ShiftDir dir>
+void WriteHeader(int bits, T poly, uint64_t window, T seed)
+{
+    const int width = bits / 4;
+    const char* type = (bits == 8)? "uint8_t" : (bits == 16)? "uint16_t" : (bits == 32)? "uint32_t" : "uint64_t";
+    std::ostringstream id;
+    id << "crc" << bits << (dir == libcrc::shiftLeft? 'l' : 'r') << '_' << std::hex << std::setw(width) << std::setfill('0') << static_cast<uint64_t>(poly);
+    std::string guard = id.str();
+    std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+    const T* tables = libcrc::TableRegistry::get<T, dir>(poly, header_slices);
+    const T* powers = libcrc::TableRegistry::getPowers<T, dir>(poly);
+    const libcrc::ClmulConstants k = libcrc::ClmulConstants::make<dir>(uint64_t(poly) << (64 - bits));
+
+    std::cout << "/**\n"
+              << " * @brief   Autogenerated constants for CRC calculation (test_libcrc++ -t header)\n"
+              << " * @note    Algorithm: CRC" << bits << ", shift " << (dir == libcrc::shiftLeft? "left" : "right")
+              << ", polynomial 0x" << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << static_cast<uint64_t>(poly) << "\n"
+              << " */\n"
+              << "#ifndef _" << guard << "_H_\n"
+              << "#define _" << guard << "_H_\n\n"
+              << "#include <stdint.h>\n\n"
+              << "namespace " << id.str() << "\n{\n"
+              << "constexpr " << type << " polynomial = 0x" << std::setw(width) << static_cast<uint64_t>(poly) << ";\n\n"
+              << "/** Lookup tables: table k holds the CRC of every byte followed by k zero bytes; slicing-by-N uses the first N */\n"
+              << "alignas(64) constexpr " << type << " tables[" << std::dec << header_slices << "][256] =\n{\n" << std::hex;
+    for (unsigned slice = 0; slice < header_slices; ++slice)
+    {
+        std::cout << "  {\n";
+        WriteValues(tables + slice * 256, 256, width, "    ");
+        std::cout << (slice + 1 < header_slices? "  },\n" : "  }\n");
+    }
+    std::cout << "};\n\n"
+              << "/** Powers x^(8 * 2^k) mod P, k = 0..63, to combine and update CRCs */\n"
+              << "alignas(64) constexpr " << type << " powers[64] =\n{\n";
+    WriteValues(powers, 64, width, "  ");
+    std::cout << "};\n\n"
+              << "/** Carry-less multiplication: multipliers to fold a lane (i + 1) * 128 bits forward {low half, high half} */\n"
+              << "alignas(64) constexpr uint64_t clmul_fold[" << std::dec << libcrc::ClmulConstants::wide_lanes << "][2] =\n{\n" << std::hex;
+    for (unsigned lane = 0; lane < libcrc::ClmulConstants::wide_lanes; ++lane)
+        std::cout << "  { 0x" << std::setw(16) << k.fold_[lane][0] << ", 0x" << std::setw(16) << k.fold_[lane][1]
+                  << (lane + 1 < libcrc::ClmulConstants::wide_lanes? " },\n" : " }\n");
+    std::cout << "};\n"
+              << "constexpr uint64_t clmul_final = 0x" << std::setw(16) << k.final_ << ";      // Reduces the last lane to 128 bits\n"
+              << "constexpr uint64_t barrett = 0x" << std::setw(16) << k.barrett_ << ";          // Barrett quotient floor(x^128 / G)\n"
+              << "constexpr uint64_t barrett_poly = 0x" << std::setw(16) << k.poly_ << ";     // Polynomial G without its x^64 term\n";
+
+    if (window != 0)
+    {
+        const T polynomial = (dir == libcrc::shiftLeft)? poly : libcrc::reverse(poly);
+        const T one = (dir == libcrc::shiftLeft)? T(1) : T(T(1) << (bits - 1));
+        const T shift = libcrc::shiftMod<T, dir>(one, window, powers, polynomial);
+        T out[256];
+        for (unsigned idx = 0; idx < 256; ++idx)
+            out[idx] = libcrc::multiplyMod<T, dir>(tables[idx], shift, polynomial);
+        std::cout << "\n/** Rolling CRC of a " << std::dec << window << "-byte window: contribution of each byte value leaving it */\n"
+                  << "constexpr uint64_t rolling_window = " << window << ";\n" << std::hex
+                  << "constexpr " << type << " rolling_seed_term = 0x" << std::setw(width)
+                  << static_cast<uint64_t>(libcrc::multiplyMod<T, dir>(seed, shift, polynomial)) << ";\n"
+                  << "alignas(64) constexpr " << type << " rolling_out[256] =\n{\n";
+        WriteValues(out, 256, width, "  ");
+        std::cout << "};\n";
+    }
+
+    std::cout << "\n#if defined(_LIBCRCPP_H_)\n"
+              << "/** Constants of CrcClmulCalc: libcrc::CrcClmulCalc<" << type << ", libcrc::" << (dir == libcrc::shiftLeft? "shiftLeft" : "shiftRight")
+              << "> calc(polynomial, clmul_constants) */\n"
+              << "alignas(64) constexpr libcrc::ClmulConstants clmul_constants =\n{\n  {\n";
+    for (unsigned lane = 0; lane < libcrc::ClmulConstants::wide_lanes; ++lane)
+        std::cout << "    { clmul_fold[" << std::dec << lane << "][0], clmul_fold[" << lane << "][1] }"
+                  << (lane + 1 < libcrc::ClmulConstants::wide_lanes? ",\n" : "\n");
+    std::cout << "  },\n  clmul_final, barrett, barrett_poly\n};\n\n"
+              << "/** Hands the tables to the registry, so that the calculators built afterwards don't build them */\n"
+              << "inline void preload()\n{\n"
+              << "    libcrc::TableRegistry::preload<" << type << ", libcrc::" << (dir == libcrc::shiftLeft? "shiftLeft" : "shiftRight")
+              << ">(polynomial, tables[0], " << header_slices << ", powers);\n"
+              << "}\n"
+              << "#endif\n\n"
+              << "} // namespace\n\n"
+              << "#endif  // _" << guard << "_H_\n";
+}
+
+/** ----------------------------------------------------
+ * @brief     Create and show a header with the constants of every engine.
+ * ------ */
+void GenerateHeader(int bits, libcrc::ShiftDir dir, uint64_t poly, uint64_t window, uint64_t seed)
+{
+    switch (bits + (dir == libcrc::shiftLeft? 0 : 1))
+    {
+        case 8:  WriteHeader<uint8_t,  libcrc::shiftLeft>(bits, uint8_t(poly), window, uint8_t(seed));    break;
+        case 16: WriteHeader<uint16_t, libcrc::shiftLeft>(bits, uint16_t(poly), window, uint16_t(seed));  break;
+        case 32: WriteHeader<uint32_t, libcrc::shiftLeft>(bits, uint32_t(poly), window, uint32_t(seed));  break;
+        case 64: WriteHeader<uint64_t, libcrc::shiftLeft>(bits, poly, window, seed);                      break;
+        case 9:  WriteHeader<uint8_t,  libcrc::shiftRight>(bits, uint8_t(poly), window, uint8_t(seed));   break;
+        case 17: WriteHeader<uint16_t, libcrc::shiftRight>(bits, uint16_t(poly), window, uint16_t(seed)); break;
+        case 33: WriteHeader<uint32_t, libcrc::shiftRight>(bits, uint32_t(poly), window, uint32_t(seed)); break;
+        case 65: WriteHeader<uint64_t, libcrc::shiftRight>(bits, poly, window, seed);                     break;
+    }
+}
+
 /** ------------------------------------------------------
- * @brief     Read a file and compute its CRC using the specified algorithm
+ * @brief     Read from a file until the buffer is full or the file ends. A negative offset reads at the current
+ *            position, for files that can't seek.
  * ------ */
-void CalculateCrc(const char* fname, int bits, libcrc::ShiftDir dir, uint64_t poly, uint64_t seed)
+ssize_t ReadFull(int fd, uint8_t* buffer, size_t size, off_t offset)
 {
-    CrcWrapper crc_calculator(bits, dir, poly);
-    FILE* f = fopen(fname, "r");
-    if (f == nullptr)
+    size_t total = 0;
+    while (total < size)
     {
-        std::cerr << "Error opening file " << fname << std::endl;
-        exit(-1);
+        ssize_t lesen = (offset < 0)? read(fd, buffer + total, size - total)
+                                    : pread(fd, buffer + total, size - total, offset + off_t(total));
+        if (lesen < 0 && errno == EINTR)
+            continue;
+        if (lesen < 0)
+            return -1;
+        if (lesen == 0)
+            break;
+        total += lesen;
+    }
+    return total;
+}
+
+/** ------------------------------------------------------
+ * @brief     Compute the CRC of a part of a file read into a large buffer.
+ * ------ */
+bool ReadCrc(const CrcWrapper& crc_calculator, int fd, off_t offset, uint64_t length, uint64_t& crc)
+{
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[read_buffer]);
+    while (length > 0)
+    {
+        ssize_t lesen = ReadFull(fd, buffer.get(), std::min<uint64_t>(length, read_buffer), offset);
+        if (lesen < 0)
+            return false;
+        if (lesen == 0)
+            break;
+        crc = crc_calculator.compute(buffer.get(), lesen, crc);
+        if (offset >= 0)
+            offset += lesen;
+        if (length != to_end)
+            length -= lesen;
+    }
+    return true;
+}
+
+/** ------------------------------------------------------
+ * @brief     Compute the CRC of a part of a file mapped in memory. Files that can't be mapped are read into a buffer.
+ * @desc      The pages are not faulted in by mmap: the kernel reads them ahead, and the next window is requested
+ *            before computing the current one, so that reading and computing overlap.
+ * ------ */
+bool MapCrc(const CrcWrapper& crc_calculator, int fd, off_t offset, uint64_t length, uint64_t& crc)
+{
+    if (offset < 0 || length == to_end)
+        return ReadCrc(crc_calculator, fd, offset, length, crc);
+    if (length == 0)
+        return true;
+
+    off_t start = offset & ~off_t(sysconf(_SC_PAGESIZE) - 1);   // Mappings start at a page boundary
+    size_t size = length + (offset - start);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, start);
+    if (map == MAP_FAILED)
+        return ReadCrc(crc_calculator, fd, offset, length, crc);
+    madvise(map, size, MADV_SEQUENTIAL);                // Aggressive read-ahead, pages dropped behind
+#if defined(MADV_HUGEPAGE)
+    madvise(map, size, MADV_HUGEPAGE);                  // Only effective where the page cache has huge pages
+#endif
+    uint8_t* base = static_cast<uint8_t*>(map);
+    for (size_t done = 0; done < size; done += map_window)     // Windows are page aligned, from the mapping start
+    {
+        if (size - done > map_window)
+            madvise(base + done + map_window, std::min(size - done - map_window, map_window), MADV_WILLNEED);
+        size_t first = std::max(done, size_t(offset - start));
+        size_t last = std::min(size, done + map_window);
+        if (first < last)
+            crc = crc_calculator.compute(base + first, last - first, crc);
     }
+    munmap(map, size);
+    return true;
+}
+
+/** ------------------------------------------------------
+ * @brief     Compute the CRC of a part of a file read ahead by another thread, so that reading and computing overlap.
+ * @desc      The reader fills one buffer while the CRC of the other one is computed. An empty buffer ends the file.
+ * ------ */
+bool AsyncCrc(const CrcWrapper& crc_calculator, int fd, off_t offset, uint64_t length, uint64_t& crc)
+{
+    if (length <= async_buffer)
+        return ReadCrc(crc_calculator, fd, offset, length, crc);
 
-    uint64_t crc = seed;
-    uint8_t buffer[4096];
+    std::unique_ptr<uint8_t[]> buffers[2] = { std::unique_ptr<uint8_t[]>(new uint8_t[async_buffer]),
+                                              std::unique_ptr<uint8_t[]>(new uint8_t[async_buffer]) };
+    ssize_t filled[2] = { 0, 0 };
+    bool ready[2] = { false, false };                   // Buffer filled by the reader, waiting to be computed
+    std::mutex mutex;
+    std::condition_variable changed;
 
-    while (!feof(f))
+    std::thread reader([&]()
     {
-        int lesen = fread(buffer, 1, 4096, f);
+        for (unsigned slot = 0; ; slot ^= 1)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return !ready[slot]; });
+            }
+            ssize_t lesen = ReadFull(fd, buffers[slot].get(), std::min<uint64_t>(length, async_buffer), offset);
+            if (lesen > 0 && offset >= 0)
+                offset += lesen;
+            if (lesen > 0 && length != to_end)
+                length -= lesen;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                filled[slot] = lesen;
+                ready[slot] = true;
+            }
+            changed.notify_all();
+            if (lesen <= 0)
+                break;
+        }
+    });
+
+    bool success = true;
+    for (unsigned slot = 0; ; slot ^= 1)
+    {
+        ssize_t lesen;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return ready[slot]; });
+            lesen = filled[slot];
+        }
         if (lesen <= 0)
+        {
+            success = (lesen == 0);
             break;
-        crc = crc_calculator.compute(buffer, lesen, crc);
+        }
+        crc = crc_calculator.compute(buffers[slot].get(), lesen, crc);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[slot] = false;
+        }
+        changed.notify_all();
+    }
+    reader.join();
+    return success;
+}
+
+/** ------------------------------------------------------
+ * @brief     File to compute. Long files are split in chunks; every chunk but the first one is computed with seed 0
+ *            and the CRCs are joined with combine() when the last chunk is done.
+ * ------ */
+struct FileJob
+{
+    std::string name;
+    uint64_t length = to_end;                           // to_end if it is not a regular file
+    std::vector<uint64_t> crcs;                         // CRC of every chunk
+    std::atomic<size_t> pending;                        // Chunks not computed yet
+    std::atomic<int> error;                             // errno of the first failure; 0 if none
+    bool done = false;                                  // Ready to be written (protected by the output mutex)
+
+    FileJob(const std::string& p_name, uint64_t p_length, int p_error)
+        : name(p_name), length(p_length), pending(0), error(p_error)
+    {
+        size_t chunks = (length == to_end || length <= split_chunk)? 1 : (length + split_chunk - 1) / split_chunk;
+        crcs.resize(chunks);
+        pending = (error == 0)? chunks : 0;
+    }
+};
+
+using FileList = std::vector<std::unique_ptr<FileJob>>;
+
+/** ------------------------------------------------------
+ * @brief     Add a file to the list; the files in a directory are added recursively, sorted by name. "-" is the
+ *            standard input.
+ * ------ */
+void AddInput(const std::string& name, FileList& files, bool follow = true)
+{
+    struct stat info;
+    if (name == "-")
+    {
+        files.emplace_back(new FileJob(name, to_end, 0));
+        return;
+    }
+    if ((follow? stat(name.c_str(), &info) : lstat(name.c_str(), &info)) != 0)
+    {
+        files.emplace_back(new FileJob(name, 0, errno));
+        return;
+    }
+    if (S_ISLNK(info.st_mode))                          // Links found in directories: only to files
+    {
+        if (stat(name.c_str(), &info) == 0 && !S_ISDIR(info.st_mode))
+            AddInput(name, files);
+        return;
+    }
+    if (!S_ISDIR(info.st_mode))
+    {
+        files.emplace_back(new FileJob(name, S_ISREG(info.st_mode)? uint64_t(info.st_size) : to_end, 0));
+        return;
+    }
+
+    DIR* dir = opendir(name.c_str());
+    if (dir == nullptr)
+    {
+        files.emplace_back(new FileJob(name, 0, errno));
+        return;
+    }
+    std::vector<std::string> entries;
+    while (struct dirent* entry = readdir(dir))
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            entries.push_back(entry->d_name);
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+    for (const std::string& entry : entries)
+        AddInput((name.back() == '/')? name + entry : name + '/' + entry, files, false);
+}
+
+/** ------------------------------------------------------
+ * @brief     Result writer. Files are written in the order given, as soon as they and the ones before are done.
+ * ------ */
+class Output
+{
+public:
+    Output(OutputStyles p_style, int p_bits, uint64_t p_poly, uint64_t p_seed)
+        : style(p_style), bits(p_bits), poly(p_poly), seed(p_seed), next(0), failed(false)
+    { }
+
+    void Done(FileList& files, FileJob& job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job.done = true;
+        for (; next < files.size() && files[next]->done; ++next)
+            Write(*files[next]);
+        std::cout << std::flush;
+    }
+
+    bool Failed() const
+    {
+        return failed;
+    }
+
+private:
+    void Write(const FileJob& job)
+    {
+        uint64_t xor_mask = 0;
+        for (int i = 0; i < bits; ++i)
+            xor_mask |= uint64_t(1) << i;
+        uint64_t crc = job.crcs[0];
+        int width = (bits + 3) / 4;
+        failed = failed || job.error != 0;
+
+        switch (style)
+        {
+            case text_output:
+                if (job.error != 0)
+                {
+                    std::cerr << "Error reading file " << job.name << ": " << strerror(job.error) << std::endl;
+                    break;
+                }
+                std::cout << "File      : " << job.name << std::endl
+                          << "Algorithm : CRC" << bits << std::endl
+                          << "Polynomial: " << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << poly << std::endl
+                          << "Seed      : " << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << seed << std::endl
+                          << "CRC       : " << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << crc << std::endl
+                          << "XOR CRC   : " << std::hex << std::uppercase << std::setw(width) << std::setfill('0') << (crc ^ xor_mask) << std::endl;
+                break;
+
+            case sum_output:
+                if (job.error != 0)
+                    std::cerr << job.name << ": " << strerror(job.error) << std::endl;
+                else
+                    std::cout << std::hex << std::nouppercase << std::setw(width) << std::setfill('0') << crc << "  " << job.name << '\n';
+                break;
+
+            case json_output:
+                std::cout << "{\"file\": \"" << Escape(job.name) << "\", ";
+                if (job.error != 0)
+                    std::cout << "\"error\": \"" << Escape(strerror(job.error)) << "\"}\n";
+                else
+                    std::cout << "\"crc\": \"" << std::hex << std::nouppercase << std::setw(width) << std::setfill('0') << crc
+                              << "\", \"xor_crc\": \"" << std::setw(width) << (crc ^ xor_mask) << "\"}\n";
+                break;
+        }
+    }
+
+    static std::string Escape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", c);
+                escaped += code;
+            }
+            else
+                escaped += c;
+        }
+        return escaped;
+    }
+
+    OutputStyles style;
+    int bits;
+    uint64_t poly;
+    uint64_t seed;
+    size_t next;                                        // First file not written
+    bool failed;                                        // Some file could not be read
+    std::mutex mutex;
+};
+
+/** ------------------------------------------------------
+ * @brief     Compute a chunk of a file. The last chunk to finish joins the CRCs of the file.
+ * ------ */
+void ComputeChunk(const CrcWrapper& crc_calculator, ReadModes mode, FileJob& job, size_t chunk, uint64_t seed)
+{
+    int fd = (job.name == "-")? 0 : open(job.name.c_str(), O_RDONLY);
+    off_t offset = (job.length == to_end)? -1 : off_t(chunk * split_chunk);
+    uint64_t length = (job.length == to_end)? to_end : std::min(split_chunk, job.length - chunk * split_chunk);
+    uint64_t crc = (chunk == 0)? seed : 0;
+    bool success = (fd >= 0);
+    if (success)
+    {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        if (offset >= 0)
+            posix_fadvise(fd, offset, length, POSIX_FADV_SEQUENTIAL);
+#endif
+        switch (mode)
+        {
+            case mmap_mode:
+                success = MapCrc(crc_calculator, fd, offset, length, crc);
+                break;
+            case async_mode:
+                success = AsyncCrc(crc_calculator, fd, offset, length, crc);
+                break;
+            default:
+                success = ReadCrc(crc_calculator, fd, offset, length, crc);
+                break;
+        }
+    }
+    int error = 0;
+    if (!success)
+        job.error.compare_exchange_strong(error, (errno != 0)? errno : EIO);
+    if (fd > 0)
+        close(fd);
+    job.crcs[chunk] = crc;
+}
+
+/** ------------------------------------------------------
+ * @brief     Compute the CRC of every file using the specified algorithm
+ * @desc      The chunks of all the files are taken in order from a shared queue by a pool of threads, so that a
+ *            thread never waits while there is work left: small files keep the threads busy, and the chunks of the
+ *            large ones are spread among all of them.
+ * ------ */
+bool CalculateCrc(FileList& files, ReadModes mode, OutputStyles style, unsigned threads, int bits, libcrc::ShiftDir dir, uint64_t poly, uint64_t seed)
+{
+    CrcWrapper crc_calculator(bits, dir, poly);
+    Output output(style, bits, poly, seed);
+
+    std::vector<std::pair<size_t, size_t>> chunks;     // File and chunk of every work item
+    for (size_t file = 0; file < files.size(); ++file)
+    {
+        if (files[file]->error != 0)
+            continue;
+        for (size_t chunk = 0; chunk < files[file]->crcs.size(); ++chunk)
+            chunks.emplace_back(file, chunk);
     }
-    fclose(f);
-
-    uint64_t xor_mask = 0;
-    for (int i = 0; i < bits; ++i)
-        xor_mask |= 1L << i;
-    std::cout << "File      : " << fname << std::endl
-              << "Algorithm : CRC" << bits << std::endl
-              << "Polynomial: " << std::hex << std::uppercase << std::setw(bits/4) << std::setfill('0') << poly << std::endl
-              << "Seed      : " << std::hex << std::uppercase << std::setw(bits/4) << std::setfill('0') << seed << std::endl
-              << "CRC       : " << std::hex << std::uppercase << std::setw(bits/4) << std::setfill('0') << crc << std::endl
-              << "XOR CRC   : " << std::hex << std::uppercase << std::setw(bits/4) << std::setfill('0') << (crc ^ xor_mask) << std::endl;
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t item = next++; item < chunks.size(); item = next++)
+        {
+            FileJob& job = *files[chunks[item].first];
+            ComputeChunk(crc_calculator, mode, job, chunks[item].second, seed);
+            if (--job.pending == 0)
+            {
+                for (size_t chunk = 1; chunk < job.crcs.size(); ++chunk)
+                    job.crcs[0] = crc_calculator.combine(job.crcs[0], job.crcs[chunk], std::min(split_chunk, job.length - chunk * split_chunk));
+                output.Done(files, job);
+            }
+        }
+    };
+
+    for (auto& job : files)                             // Files that could not be opened are written in their place
+        if (job->error != 0)
+            output.Done(files, *job);
+
+    std::vector<std::thread> pool;
+    for (unsigned idx = 1; idx < std::min<size_t>(threads, chunks.size()); ++idx)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool)
+        thread.join();
+    return !output.Failed();
 }
 
 /** ----------------------------------------------------
@@ -246,14 +813,23 @@ void CalculateCrc(const char* fname, int bits, libcrc::ShiftDir dir, uint64_t po
 void Abort(const char* prog)
 {
     std::cout << prog << " : CRC polynomial calculator and lookup table generator.\n"
-        "Syntax: " << prog << " -h | [ -f <file> | -t <format> ] -b <bits> -d <direction> -p <polynomial> [-s <seed>]\n"
+        "Syntax: " << prog << " -h | [ -f <file> [-m <mode>] [-o <output>] [-j <threads>] [<file>...] | -t <format> [-w <window>] ]\n"
+        "       -b <bits> -d <direction> -p <polynomial> [-s <seed>]\n"
         "  -h : This help\n"
-        "  -f : Calculate a CRC of a file\n"
-        "       <file>      : File to read for calculating its CRC\n"
+        "  -f : Calculate a CRC of a file; may be repeated, and more files can follow the options\n"
+        "       <file>      : File to read for calculating its CRC; directories are read recursively, '-' is stdin\n"
+        "  -m : File reading mode [read]\n"
+        "       <mode>      : read = large buffer, mmap = memory mapped, async = read ahead by another thread\n"
+        "  -o : Output format [text]\n"
+        "       <output>    : text = report, sum = '<crc>  <file>' lines, json = a JSON object per line\n"
+        "  -j : Threads computing the files [number of CPUs]\n"
+        "       <threads>   : Number of threads\n"
         "  -t : Generate a CRC lookup table\n"
-        "       <format>    : Formato de la tabla: { 'c', 'dec', 'hex'}\n"
+        "       <format>    : Formato de la tabla: { 'c', 'dec', 'hex'}, or 'header' for the constants of every engine\n"
+        "  -w : Window of the rolling CRC table in the header [none]\n"
+        "       <window>    : Length of the window, in bytes\n"
         "  -b : CRC length in bits\n"
-        "       <bits>      : Number of bits of the CRC (8, 16, 32, 64)\n"
+        "       <bits>      : Number of bits of the CRC, 1 to 64 (8, 16, 32, 64 for -t)\n"
         "  -d : Input bits direction [left]\n"
         "       <direction> : l = left, r = right\n"
         "  -p : Polynomial to use\n"
@@ -269,8 +845,6 @@ void Abort(const char* prog)
  * ------*/
 int main(int argc, char* argv[])
 {
-    Banner();
-
     if (argc < 2)
     {
         std::cerr << "Run '" << argv[0] << " -h' for a list of options." << std::endl;
@@ -278,17 +852,20 @@ int main(int argc, char* argv[])
     }
 
     /*--- Command-line processing ---*/
-    const char* fname = nullptr;
+    FileList files;
     PrintStyles format = no_style;
+    ReadModes mode = read_mode;
+    OutputStyles output = text_output;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
     int bits = 0;
     libcrc::ShiftDir dir = libcrc::shiftLeft;
     uint64_t poly = 0;
     uint64_t seed = 0;
-
+    uint64_t window = 0;
 
     for (bool stop = false; stop == false; )
     {
-        switch (getopt(argc, argv, "hf:t:b:d:p:s:"))
+        switch (getopt(argc, argv, "hf:m:o:j:t:w:b:d:p:s:"))
         {
             case 'h':
                 Abort(argv[0]);
@@ -300,11 +877,48 @@ int main(int argc, char* argv[])
                   std::cerr << "Please specify either -f or -t." << std::endl;
                   exit(-1);
                 }
-                fname = optarg;
+                AddInput(optarg, files);
+                break;
+
+            case 'm':                                   // File reading mode
+                if (strcasecmp(optarg, "read") == 0)
+                    mode = read_mode;
+                else if (strcasecmp(optarg, "mmap") == 0)
+                    mode = mmap_mode;
+                else if (strcasecmp(optarg, "async") == 0)
+                    mode = async_mode;
+                else
+                {
+                    std::cerr << "Mode " << optarg << " unknown" << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'o':                                   // Output format
+                if (strcasecmp(optarg, "text") == 0)
+                    output = text_output;
+                else if (strcasecmp(optarg, "sum") == 0)
+                    output = sum_output;
+                else if (strcasecmp(optarg, "json") == 0)
+                    output = json_output;
+                else
+                {
+                    std::cerr << "Output " << optarg << " unknown" << std::endl;
+                    exit(-1);
+                }
+                break;
+
+            case 'j':
+                threads = strtoul(optarg, 0, 0);
+                if (threads < 1)
+                {
+                    std::cerr << "At least one thread is needed." << std::endl;
+                    exit(-1);
+                }
                 break;
 
             case 't':                                   // Generate lookup table
-                if (fname != nullptr)
+                if (!files.empty())
                 {
                     std::cerr << "Please specify either -f or -t." << std::endl;
                     exit(-1);
@@ -315,6 +929,8 @@ int main(int argc, char* argv[])
                     format = dec_style;
                 else if (strcasecmp(optarg, "hex") == 0)
                     format = hex_style;
+                else if (strcasecmp(optarg, "header") == 0)
+                    format = header_style;
                 else
                 {
                     std::cerr << "Format " << optarg << " unknown" << std::endl;
@@ -322,11 +938,15 @@ int main(int argc, char* argv[])
                 }
                 break;
 
+            case 'w':
+                window = strtoull(optarg, 0, 0);
+                break;
+
             case 'b':
                 bits = strtoul(optarg, 0, 0);
-                if (bits < 8 || bits > 64)
+                if (bits < 1 || bits > 64)
                 {
-                    std::cerr << "Allowed bit lengths are: 8, 16, 32, 64." << std::endl;
+                    std::cerr << "Allowed bit lengths are 1 to 64." << std::endl;
                     exit(-1);
                 }
                 break;
@@ -362,11 +982,30 @@ int main(int argc, char* argv[])
         }
     }
 
+    for (; optind < argc; ++optind)                     // Files after the options
+    {
+        if (format != no_style)
+        {
+            std::cerr << "Please specify either -f or -t." << std::endl;
+            exit(-1);
+        }
+        AddInput(argv[optind], files);
+    }
+
     /*--- Do the calculation ---*/
-    if (format != no_style)
+    if (output == text_output && format != header_style)
+      Banner();
+    if (format != no_style && bits != 8 && bits != 16 && bits != 32 && bits != 64)
+    {
+      std::cerr << "Lookup tables are generated for 8, 16, 32 and 64 bits." << std::endl;
+      exit(-1);
+    }
+    if (format == header_style)
+      GenerateHeader(bits, dir, poly, window, seed);
+    else if (format != no_style)
       GenerateTable(format, bits, dir, poly);
-    else if (fname != nullptr)
-      CalculateCrc(fname, bits, dir, poly, seed);
+    else if (!files.empty())
+      return CalculateCrc(files, mode, output, threads, bits, dir, poly, seed)? 0 : -1;
     else
       std::cerr << "Please specify either '-f' or '-t'" << std::endl;
 }